@@ -52,8 +52,10 @@ fast_downward_plugin(
     HELP "Core source files"
     SOURCES
         abstract_task.cc
+        algorithms/int_hash_set.h
         axioms.cc
         causal_graph.cc
+        depth_histogram.cc
         equivalence_relation.cc
         evaluation_context.cc
         evaluation_result.cc
@@ -91,6 +93,7 @@ fast_downward_plugin(
         open_lists/open_list.cc
         open_lists/open_list_factory.cc
         open_lists/pareto_open_list.cc
+        open_lists/potential_open_list.cc
         open_lists/standard_scalar_open_list.cc
         open_lists/tiebreaking_open_list.cc
         open_lists/type_based_open_list.cc
@@ -133,11 +136,13 @@ fast_downward_plugin(
         utils/markup.cc
         utils/math.cc
         utils/memory.cc
+        utils/memory_mapped_file.cc
         utils/rng.cc
         utils/rng_options.cc
         utils/system.cc
         utils/system_unix.cc
         utils/system_windows.cc
+        utils/thread_pool.cc
         utils/timer.cc
     CORE_PLUGIN
 )
@@ -443,7 +448,10 @@ fast_downward_plugin(
     HELP "The Merge-and-Shrink heuristic"
     SOURCES
         dijkstra_search/dijkstra_search.cc
+        dijkstra_search/lexicographic_queue.h
+        dijkstra_search/min_plus.cc
 	dijkstra_search/pareto_front.cc
+        dijkstra_search/pareto_front_table.cc
 	merge_and_shrink/distances.cc
         merge_and_shrink/factored_transition_system.cc
         merge_and_shrink/fts_factory.cc
@@ -516,7 +524,10 @@ fast_downward_plugin(
     HELP "Plugin containing the code for PDBs"
     SOURCES
         dijkstra_search/dijkstra_search.cc
+        dijkstra_search/lexicographic_queue.h
+        dijkstra_search/min_plus.cc
         dijkstra_search/pareto_front.cc
+        dijkstra_search/pareto_front_table.cc
         pdbs/canonical_pdbs.cc
         pdbs/canonical_pdbs_heuristic.cc
         pdbs/dominance_pruning.cc
@@ -524,6 +535,7 @@ fast_downward_plugin(
         pdbs/match_tree.cc
         pdbs/max_additive_pdb_sets.cc
         pdbs/max_cliques.cc
+        pdbs/pareto_objectives.h
         pdbs/pattern_collection_information.cc
         pdbs/pattern_database.cc
         pdbs/pattern_collection_generator_combo.cc
@@ -534,6 +546,8 @@ fast_downward_plugin(
         pdbs/pattern_generator_greedy.cc
         pdbs/pattern_generator_manual.cc
         pdbs/pattern_generator.cc
+        pdbs/pdb_builder.cc
+        pdbs/pdb_cache.cc
         pdbs/pdb_heuristic.cc
         pdbs/types.h
         pdbs/validation.cc
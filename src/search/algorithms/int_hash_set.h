@@ -0,0 +1,180 @@
+#ifndef ALGORITHMS_INT_HASH_SET_H
+#define ALGORITHMS_INT_HASH_SET_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+/*
+  Hash set of non-negative ints whose hash and equality are defined by
+  the caller, e.g. IDs of objects that are compared by value.
+
+  The set uses open addressing with linear probing. Every bucket stores
+  the 32-bit hash of its key next to the key, so most probes are
+  decided without calling Equal. Keys cannot be removed.
+
+  When the table gets full, a table of twice the size is allocated and
+  the old buckets are moved over a few at a time by the following
+  inserts, so there is no pause for rehashing the whole set. Until then,
+  keys are looked up in both tables.
+*/
+template<typename Hasher, typename Equal>
+class IntHashSet {
+    static const int EMPTY = -1;
+    static const int MIN_CAPACITY_LOG = 4;
+    // Number of old buckets moved to the new table per insert.
+    static const int MIGRATION_STEP = 4;
+
+    struct Bucket {
+        int key;
+        std::uint32_t hash;
+
+        Bucket() : key(EMPTY), hash(0) {
+        }
+    };
+
+    /*
+      Buckets are indexed with Fibonacci hashing on the stored hash, so
+      that the bucket depends on all bits of the hash and not only on
+      the low ones.
+    */
+    struct Table {
+        std::vector<Bucket> buckets;
+        int capacity_log;
+
+        Table()
+            : capacity_log(0) {
+        }
+
+        explicit Table(int capacity_log)
+            : buckets(std::size_t(1) << capacity_log),
+              capacity_log(capacity_log) {
+        }
+
+        std::size_t get_capacity() const {
+            return buckets.size();
+        }
+
+        std::size_t get_home_bucket(std::uint32_t hash) const {
+            return static_cast<std::uint32_t>(hash * 2654435769u) >>
+                   (32 - capacity_log);
+        }
+
+        std::size_t get_next_bucket(std::size_t bucket) const {
+            return (bucket + 1) & (buckets.size() - 1);
+        }
+
+        // Returns the bucket holding key or the empty bucket ending its probe.
+        template<typename KeyEqual>
+        std::size_t find(std::uint32_t hash, const KeyEqual &equal) const {
+            std::size_t bucket = get_home_bucket(hash);
+            while (buckets[bucket].key != EMPTY &&
+                   !(buckets[bucket].hash == hash &&
+                     equal(buckets[bucket].key))) {
+                bucket = get_next_bucket(bucket);
+            }
+            return bucket;
+        }
+
+        void insert_new(const Bucket &entry) {
+            std::size_t bucket = get_home_bucket(entry.hash);
+            while (buckets[bucket].key != EMPTY)
+                bucket = get_next_bucket(bucket);
+            buckets[bucket] = entry;
+        }
+    };
+
+    Hasher hasher;
+    Equal equal;
+    Table table;
+    // Buckets not moved yet, empty if the set is not growing.
+    Table old_table;
+    std::size_t num_migrated;
+    std::size_t num_entries;
+
+    static std::uint32_t fold_hash(std::size_t hash) {
+        return static_cast<std::uint32_t>(hash ^ (std::uint64_t(hash) >> 32));
+    }
+
+    bool is_growing() const {
+        return !old_table.buckets.empty();
+    }
+
+    void migrate(std::size_t num_buckets) {
+        std::size_t end = std::min(num_migrated + num_buckets,
+                                   old_table.get_capacity());
+        for (; num_migrated < end; ++num_migrated) {
+            const Bucket &entry = old_table.buckets[num_migrated];
+            if (entry.key != EMPTY)
+                table.insert_new(entry);
+        }
+        if (num_migrated == old_table.get_capacity()) {
+            old_table = Table();
+            num_migrated = 0;
+        }
+    }
+
+    /*
+      Tables are kept at most half full. The old table is half full when
+      growing starts, so its buckets are all moved before the new table
+      is half full because every insert moves MIGRATION_STEP > 2 of them.
+    */
+    void grow() {
+        assert(!is_growing());
+        old_table = std::move(table);
+        table = Table(old_table.capacity_log + 1);
+        num_migrated = 0;
+        migrate(MIGRATION_STEP);
+    }
+
+public:
+    IntHashSet(const Hasher &hasher, const Equal &equal)
+        : hasher(hasher),
+          equal(equal),
+          table(MIN_CAPACITY_LOG),
+          num_migrated(0),
+          num_entries(0) {
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    /*
+      Inserts key unless an equal key is present. Returns the key in the
+      set and whether it was inserted.
+    */
+    std::pair<int, bool> insert(int key) {
+        assert(key >= 0);
+        if (is_growing())
+            migrate(MIGRATION_STEP);
+
+        std::uint32_t hash = fold_hash(hasher(key));
+        auto equals_key = [this, key](int other) {
+                              return equal(other, key);
+                          };
+        std::size_t bucket = table.find(hash, equals_key);
+        if (table.buckets[bucket].key != EMPTY)
+            return std::make_pair(table.buckets[bucket].key, false);
+        if (is_growing()) {
+            std::size_t old_bucket = old_table.find(hash, equals_key);
+            if (old_table.buckets[old_bucket].key != EMPTY)
+                return std::make_pair(old_table.buckets[old_bucket].key, false);
+        }
+
+        if (2 * (num_entries + 1) > table.get_capacity()) {
+            grow();
+            bucket = table.find(hash, equals_key);
+        }
+        table.buckets[bucket].key = key;
+        table.buckets[bucket].hash = hash;
+        ++num_entries;
+        return std::make_pair(key, true);
+    }
+};
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*
+  Microbenchmark for ParetoFront::merge_additive. Merges random fronts
+  with 1 to 512 pairs under every (min, +) kernel this CPU supports
+  (see dijkstra_search/min_plus.h) and prints the time per merge. The
+  scalar kernel is the path taken without SIMD support. All kernels
+  must produce the same merged fronts, which is checked via a checksum.
+
+  Built with -DBUILD_MERGE_BENCHMARK=TRUE; usage: merge_benchmark
+*/
+
+#include "../dijkstra_search/min_plus.h"
+#include "../dijkstra_search/pareto_front.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const int NUM_FRONTS = 64;
+
+// Front with n pairs: h strictly ascending, d strictly descending.
+static ParetoFront create_front(int n, mt19937 &rng) {
+    ParetoFront front;
+    int h = rng() % 5;
+    int d = 2 * n + rng() % 5;
+    for (int i = 0; i < n; ++i) {
+        front.append_pair(ParetoFront::ParetoPair(h, d));
+        h += 1 + rng() % 3;
+        d -= 1 + rng() % 2;
+    }
+    return front;
+}
+
+int main() {
+    const vector<string> kernels = min_plus::get_available_implementations();
+    const vector<int> sizes = {1, 2, 4, 8, 16, 32, 64, 128, 256, 512};
+
+    cout << "ns per merge_additive" << endl << setw(6) << "n";
+    for (const string &kernel : kernels)
+        cout << setw(12) << kernel;
+    cout << endl;
+
+    for (int n : sizes) {
+        mt19937 rng(n);
+        vector<ParetoFront> lhs;
+        vector<ParetoFront> rhs;
+        for (int i = 0; i < NUM_FRONTS; ++i) {
+            lhs.push_back(create_front(n, rng));
+            rhs.push_back(create_front(n, rng));
+        }
+        // Prune about half of the cross product.
+        const int bound = 4 * n + 10;
+        const long iterations = max(2000L, 20000000L / (long(n) * n));
+
+        cout << setw(6) << n;
+        long expected_checksum = -1;
+        for (const string &kernel : kernels) {
+            min_plus::use_implementation(kernel);
+            long checksum = 0;
+            auto start = chrono::steady_clock::now();
+            for (long i = 0; i < iterations; ++i) {
+                ParetoFront merged = lhs[i % NUM_FRONTS];
+                merged.merge_additive(rhs[(7 * i) % NUM_FRONTS], bound);
+                for (const ParetoFront::ParetoPair p : merged.view())
+                    checksum += p.h * 31 + p.d;
+            }
+            chrono::duration<double, nano> elapsed =
+                chrono::steady_clock::now() - start;
+            cout << setw(12) << fixed << setprecision(1)
+                 << elapsed.count() / iterations << flush;
+
+            if (expected_checksum == -1) {
+                expected_checksum = checksum;
+            } else if (checksum != expected_checksum) {
+                cout << endl << "Kernel " << kernel
+                     << " merged differently from " << kernels.front()
+                     << endl;
+                return EXIT_FAILURE;
+            }
+        }
+        cout << endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#include "depth_histogram.h"
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+/*
+  Relative safety margin for the refresh threshold. pow() is accurate
+  to a few ulps, so recomputing b slightly before the exact crossing
+  point guarantees that we never miss an increase.
+*/
+static const double THRESHOLD_MARGIN = 1e-9;
+
+DepthHistogram::DepthHistogram()
+    : total(0),
+      branching_factor(1),
+      refresh_threshold(MIN_SAMPLES) {
+}
+
+long long DepthHistogram::get_num_shallow_samples() const {
+    return counts.empty() ? 0 : total - counts.back();
+}
+
+void DepthHistogram::refresh() {
+    const int max_depth = static_cast<int>(counts.size()) - 2;
+    const long long shallow = get_num_shallow_samples();
+    if (max_depth <= 0) {
+        // Nothing to estimate b from until the search gets deeper.
+        branching_factor = 1;
+        refresh_threshold = numeric_limits<double>::infinity();
+    } else if (shallow < MIN_SAMPLES) {
+        branching_factor = 1;
+        refresh_threshold = MIN_SAMPLES;
+    } else {
+        branching_factor = static_cast<int>(pow(shallow, 1.0 / max_depth));
+        refresh_threshold = pow(branching_factor + 1, max_depth) *
+                            (1 - THRESHOLD_MARGIN);
+    }
+}
+
+void DepthHistogram::add(int depth) {
+    assert(depth >= 0);
+    const bool deeper = static_cast<size_t>(depth) >= counts.size();
+    if (deeper)
+        counts.resize(depth + 1, 0);
+    ++counts[depth];
+    ++total;
+    if (deeper || get_num_shallow_samples() >= refresh_threshold)
+        refresh();
+}
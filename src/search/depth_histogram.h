@@ -0,0 +1,46 @@
+#ifndef DEPTH_HISTOGRAM_H
+#define DEPTH_HISTOGRAM_H
+
+#include <vector>
+
+/*
+  Counts heuristic evaluations per search depth (number of operators
+  from the initial state) and estimates the branching factor b of the
+  search from them, as used by the expected-work objective of the
+  Pareto front heuristics.
+
+  With m being the deepest depth seen so far minus one and N the
+  number of evaluations at depths <= m, the estimate is N^(1/m),
+  rounded down, or 1 while N < MIN_SAMPLES.
+
+  The sum N is maintained incrementally and b is only recomputed when
+  a deeper level appears or when N reaches the point at which the
+  rounded estimate can grow, so add() takes amortised constant time.
+
+  Each search engine owns one histogram and hands it to heuristics
+  via the EvaluationContext.
+*/
+class DepthHistogram {
+    static const int MIN_SAMPLES = 10000;
+
+    std::vector<int> counts;
+    long long total;
+    int branching_factor;
+    // Sum over the shallower depths at which b has to be recomputed.
+    double refresh_threshold;
+
+    long long get_num_shallow_samples() const;
+    void refresh();
+
+public:
+    DepthHistogram();
+    ~DepthHistogram() = default;
+
+    void add(int depth);
+
+    int get_branching_factor() const {
+        return branching_factor;
+    }
+};
+
+#endif
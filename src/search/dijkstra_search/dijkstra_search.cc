@@ -1,10 +1,49 @@
 #include "dijkstra_search.h"
 
-#include "../priority_queue.h"
+#include "lexicographic_queue.h"
 
+#include <algorithm>
 #include <cassert>
 
 
+DijkstraSearch::TransitionGraph::TransitionGraph()
+  : TransitionGraph(0) {
+}
+
+DijkstraSearch::TransitionGraph::TransitionGraph(size_t num_states)
+  : offsets(num_states + 1, 0), max_cost(0) {
+}
+
+void DijkstraSearch::TransitionGraph::add_transition(const size_t id,
+						     const int transition_cost) {
+  transitions.emplace_back(id, transition_cost);
+  max_cost = max(max_cost, transition_cost);
+}
+
+void DijkstraSearch::TransitionGraph::close_state() {
+  offsets.push_back(transitions.size());
+}
+
+void DijkstraSearch::TransitionGraph::count_transition(const size_t state) {
+  ++offsets[state];
+}
+
+void DijkstraSearch::TransitionGraph::allocate() {
+  // Turn the counts into the end offset of each state. set_transition
+  // fills each state from the back, leaving offsets[s] at its start.
+  for(size_t i = 1; i < offsets.size(); i++)
+    offsets[i] += offsets[i - 1];
+  transitions.resize(offsets.back(), Successor(0, 0));
+}
+
+void DijkstraSearch::TransitionGraph::set_transition(const size_t state,
+						     const size_t id,
+						     const int transition_cost) {
+  transitions[--offsets[state]] = Successor(id, transition_cost);
+  max_cost = max(max_cost, transition_cost);
+}
+
+
 DijkstraSearch::DijkstraSearch(int bound)
   : bound(bound) {
   inits[FORWARD] = false;
@@ -15,11 +54,20 @@ DijkstraSearch::DijkstraSearch(int bound)
 
   computed[FORWARD][PARETO] = false;
   computed[BACKWARD][PARETO] = false;
+
+  max_transition_cost[FORWARD] = INF;
+  max_transition_cost[BACKWARD] = INF;
+
+  use_transition_graph[FORWARD] = false;
+  use_transition_graph[BACKWARD] = false;
 }
   
 bool DijkstraSearch::is_bounded() const {
   return bound < INF;
 }
+int DijkstraSearch::get_bound() const {
+  return bound;
+}
 bool DijkstraSearch::is_init(Direction dir) const {
   return inits[dir];
 }
@@ -29,13 +77,59 @@ bool DijkstraSearch::is_computed(Direction dir, Algorithm alg) const {
 void DijkstraSearch::init(Direction dir,
 			  function<vector<Successor>(const size_t)> transition_func,
 			  vector<size_t> queue_init,
-			  size_t max_size) {
+			  size_t max_size,
+			  int max_transition_cost) {
   this->transition_func[dir] = transition_func;
   this->queue_init[dir] = queue_init;
+  this->max_transition_cost[dir] = max_transition_cost;
+  this->transition_graph[dir] = TransitionGraph();
+  use_transition_graph[dir] = false;
+  inits[dir] = true;
+  pareto[dir].resize(max_size);
+}
+void DijkstraSearch::init(Direction dir,
+			  TransitionGraph transition_graph,
+			  vector<size_t> queue_init) {
+  const size_t max_size = transition_graph.get_num_states();
+  this->max_transition_cost[dir] = transition_graph.get_max_transition_cost();
+  this->transition_graph[dir] = move(transition_graph);
+  this->transition_func[dir] = nullptr;
+  use_transition_graph[dir] = true;
+  this->queue_init[dir] = queue_init;
   inits[dir] = true;
   pareto[dir].resize(max_size);
 }
 
+void DijkstraSearch::release_transitions(Direction dir) {
+  transition_func[dir] = nullptr;
+  transition_graph[dir] = TransitionGraph();
+}
+
+pair<const DijkstraSearch::Successor *, const DijkstraSearch::Successor *>
+DijkstraSearch::get_transitions(Direction dir, const size_t state,
+				vector<Successor>& buffer) {
+  if(use_transition_graph[dir]) {
+    const TransitionGraph &graph = transition_graph[dir];
+    return make_pair(graph.begin(state), graph.end(state));
+  }
+  buffer = transition_func[dir](state);
+  return make_pair(buffer.data(), buffer.data() + buffer.size());
+}
+
+
+bool DijkstraSearch::use_bucket_queue(Direction dir) const {
+  // Set by the CMake option of the same name.
+#ifdef FORCE_LEXICOGRAPHIC_MAP_QUEUE
+  const bool force_map_queue = true;
+#else
+  const bool force_map_queue = false;
+#endif
+  // With small integer costs the h values pushed during the sweep
+  // stay small (at most the bound, or the cost times the depth),
+  // so one bucket per h value is cheap.
+  return !force_map_queue &&
+    max_transition_cost[dir] <= MAX_BUCKET_QUEUE_COST;
+}
 
 void DijkstraSearch::compute(Direction dir, Algorithm alg) {
   assert(is_init(dir));
@@ -51,33 +145,46 @@ void DijkstraSearch::compute(Direction dir, Algorithm alg) {
        << "Dijkstra Search with Cost-Bound: "
        << bound << endl;
 
+  if(use_bucket_queue(dir)) {
+    LexicographicBucketQueue lex_queue;
+    compute(dir, alg, lex_queue);
+  } else {
+    LexicographicMapQueue lex_queue;
+    compute(dir, alg, lex_queue);
+  }
+  pareto[dir].finalise();
+
+  computed[dir][alg] = true;
+  if(alg == PARETO)
+    computed[dir][ORDINARY] = true;
+}
+
+template<class LexQueue>
+void DijkstraSearch::compute(Direction dir, Algorithm alg, LexQueue& lex_queue) {
+
   // Inform the bounds with opposite direction cost if computed
   Direction opposite_dir = (dir == FORWARD) ? BACKWARD : FORWARD;
   bool inform = is_computed(opposite_dir, ORDINARY);
   
-  auto& transitions = transition_func[dir];
+  vector<Successor> buffer;
   auto& pareto_fronts = pareto[dir];
   auto& opposite_pareto_fronts = pareto[opposite_dir];
 
-  // Multimap ordered on pareto pair operator<
-  // will act as a lexicographical queue with
-  // O(log(n)) insertion and O(1) pop
-  multimap<ParetoFront::ParetoPair, size_t> lex_queue;
-
   if(is_computed(dir, ORDINARY)) {
     // Reconstruct the lex_queue from the ordinary search
     // rather than re-exploring the cheapest nodes
+    pareto_fronts.reopen();
     for(size_t i = 0; i < pareto_fronts.size(); i++) {
-      if(!pareto_fronts[i].empty()) {
-	const ParetoFront::ParetoPair node_pair = pareto_fronts[i].get_min_h_pair();
+      if(!pareto_fronts.empty(i)) {
+	const ParetoFront::ParetoPair node_pair = pareto_fronts.get_min_h_pair(i);
 	const size_t state = i;
 	if(inform) {
-	  expand(state, node_pair,
-		 lex_queue, transitions,
+	  expand(node_pair,
+		 lex_queue, get_transitions(dir, state, buffer),
 		 pareto_fronts, opposite_pareto_fronts);
 	} else {
-	  expand(state, node_pair,
-		 lex_queue, transitions,
+	  expand(node_pair,
+		 lex_queue, get_transitions(dir, state, buffer),
 		 pareto_fronts);
 	}
       }
@@ -85,72 +192,66 @@ void DijkstraSearch::compute(Direction dir, Algorithm alg) {
   } else {
     // Initialise the lex queue
     for(size_t init_state : queue_init[dir]) {
-      lex_queue.emplace(ParetoFront::ParetoPair(0,0), init_state);
+      lex_queue.push(ParetoFront::ParetoPair(0,0), init_state);
     }
   }
   
   while(!lex_queue.empty()) {
-    auto pop = lex_queue.begin();
-    const ParetoFront::ParetoPair node_pair = pop->first;
-    const size_t state = pop->second;
-    lex_queue.erase(pop);
-
-    ParetoFront &state_frontier = pareto_fronts[state];
-    if((state_frontier.empty() || alg == PARETO) &&
-       state_frontier.append_pair(node_pair)) {
+    const typename LexQueue::Entry pop = lex_queue.pop();
+    const ParetoFront::ParetoPair node_pair = pop.first;
+    const size_t state = pop.second;
+
+    if((pareto_fronts.empty(state) || alg == PARETO) &&
+       pareto_fronts.append_pair(state, node_pair)) {
       if(inform) {
-	expand(state, node_pair,
-	       lex_queue, transitions,
+	expand(node_pair,
+	       lex_queue, get_transitions(dir, state, buffer),
 	       pareto_fronts, opposite_pareto_fronts);
       } else {
-	expand(state, node_pair,
-	       lex_queue, transitions,
+	expand(node_pair,
+	       lex_queue, get_transitions(dir, state, buffer),
 	       pareto_fronts);
       }
     }
-
-    computed[dir][alg] = true;
-    if(alg == PARETO)
-      computed[dir][ORDINARY] = true;
   }
 }
 
-void DijkstraSearch::expand(size_t state,
-			    ParetoFront::ParetoPair node_pair,
-			    multimap<ParetoFront::ParetoPair, size_t>& lex_queue,
-			    function<vector<Successor>(const size_t)>& transitions,
-			    std::vector<ParetoFront>& pareto_fronts) {
-  for(auto successor : transitions(state)) {
+template<class LexQueue>
+void DijkstraSearch::expand(ParetoFront::ParetoPair node_pair,
+			    LexQueue& lex_queue,
+			    pair<const Successor *, const Successor *> transitions,
+			    ParetoFrontTable& pareto_fronts) {
+  for(const Successor *it = transitions.first; it != transitions.second; ++it) {
+    const Successor &successor = *it;
     const ParetoFront::ParetoPair successor_pair =
       ParetoFront::ParetoPair(node_pair.h + successor.transition_cost,
 			      node_pair.d + 1);
-    ParetoFront& successor_front = pareto_fronts[successor.id];
 	
     // Only enque if the node is within the cost boundary and non-dominated
     if (successor_pair.h <= bound &&
-	successor_front.is_appendable(successor_pair)) {
-      lex_queue.emplace(successor_pair, successor.id);
+	pareto_fronts.is_appendable(successor.id, successor_pair)) {
+      lex_queue.push(successor_pair, successor.id);
     }
   }
 }
 
-void DijkstraSearch::expand(size_t state,
-			    ParetoFront::ParetoPair node_pair,
-			    multimap<ParetoFront::ParetoPair, size_t>& lex_queue,
-			    function<vector<Successor>(const size_t)>& transitions,
-			    std::vector<ParetoFront>& pareto_fronts,
-			    std::vector<ParetoFront>& opposite_pareto_fronts) {
-  for(auto successor : transitions(state)) {
+template<class LexQueue>
+void DijkstraSearch::expand(ParetoFront::ParetoPair node_pair,
+			    LexQueue& lex_queue,
+			    pair<const Successor *, const Successor *> transitions,
+			    ParetoFrontTable& pareto_fronts,
+			    const ParetoFrontTable& opposite_pareto_fronts) {
+  for(const Successor *it = transitions.first; it != transitions.second; ++it) {
+    const Successor &successor = *it;
     const ParetoFront::ParetoPair successor_pair =
       ParetoFront::ParetoPair(node_pair.h + successor.transition_cost,
 			      node_pair.d + 1);
-    ParetoFront& successor_front = pareto_fronts[successor.id];
-    int opposite_cost = opposite_pareto_fronts[successor.id].get_min_h_pair().h;
+    int opposite_cost = opposite_pareto_fronts.get_min_h_pair(successor.id).h;
 	
     // Only enque if the node is within the cost boundary and non-dominated
     if (successor_pair.h <= bound - opposite_cost &&
-	successor_front.is_appendable(successor_pair)) {
-      lex_queue.emplace(successor_pair, successor.id);
+	pareto_fronts.is_appendable(successor.id, successor_pair)) {
+      lex_queue.push(successor_pair, successor.id);
     }
   }
 }
@@ -163,18 +264,38 @@ void DijkstraSearch::clear(Direction dir) {
 }
 
 int DijkstraSearch::get_value(Direction dir, const size_t state) const {
-  return pareto[dir].at(state).get_min_h_pair().h;
+  return pareto[dir].get_min_h_pair(state).h;
 }
-ParetoFront& DijkstraSearch::get_pareto_front(Direction dir, const size_t state) {
-  return pareto[dir][state];
+ParetoFrontView DijkstraSearch::get_pareto_front(Direction dir, const size_t state) const {
+  return pareto[dir].get_front(state);
 }
 
 
-void DijkstraSearch::set_values(Direction dir, vector<ParetoFront>& new_distances) {
+void DijkstraSearch::set_values(Direction dir, ParetoFrontTable new_distances) {
+  // The new values are distances, so the ordinary search counts as
+  // computed.
   clear(dir);
-  for(size_t i = 0; i < new_distances.size(); i++) {
-    if(!new_distances[i].empty()) {
-      pareto[dir][i] = new_distances[i];
-    }
-  }
+  pareto[dir] = move(new_distances);
+  pareto[dir].finalise();
+  computed[dir][ORDINARY] = true;
+}
+
+const ParetoFrontTable &DijkstraSearch::get_pareto_fronts(Direction dir) const {
+  return pareto[dir];
+}
+
+void DijkstraSearch::set_pareto_fronts(Direction dir, ParetoFrontTable fronts,
+				       Algorithm alg) {
+  assert(fronts.is_finalised());
+  clear(dir);
+  pareto[dir] = move(fronts);
+  // A Pareto sweep also yields the ordinary distances.
+  computed[dir][ORDINARY] = true;
+  computed[dir][PARETO] = (alg == PARETO);
+}
+
+ParetoFrontTable DijkstraSearch::release_pareto_fronts(Direction dir) {
+  ParetoFrontTable fronts = move(pareto[dir]);
+  clear(dir);
+  return fronts;
 }
@@ -2,11 +2,12 @@
 #define DIJKSTRA_SEARCH_DIJKSTRA_SEARCH_H
 
 #include "pareto_front.h"
+#include "pareto_front_table.h"
 
 #include <functional>
 #include <vector>
 #include <limits>
-#include <map>
+#include <utility>
 
 using namespace std;
 
@@ -18,6 +19,48 @@ class DijkstraSearch {
   Successor(const size_t id, const int transition_cost)
   : id(id), transition_cost(transition_cost) {}
   };
+
+  /*
+    Transitions of all states in compressed sparse row form: the
+    transitions of state s are stored contiguously in
+    [begin(s), end(s)), so iterating them never allocates.
+
+    The graph can be built in two ways:
+    - in order of states, calling add_transition for each transition
+      of the current state followed by close_state, or
+    - for transitions that arrive in no particular order, calling
+      count_transition(s) once per transition of s, then allocate(),
+      then set_transition(s, ...) once per transition again.
+  */
+  class TransitionGraph {
+    vector<size_t> offsets;
+    vector<Successor> transitions;
+    int max_cost;
+  public:
+    TransitionGraph();
+    explicit TransitionGraph(size_t num_states);
+
+    void add_transition(const size_t id, const int transition_cost);
+    void close_state();
+
+    void count_transition(const size_t state);
+    void allocate();
+    void set_transition(const size_t state,
+			const size_t id, const int transition_cost);
+
+    size_t get_num_states() const {
+      return offsets.size() - 1;
+    }
+    int get_max_transition_cost() const {
+      return max_cost;
+    }
+    const Successor *begin(const size_t state) const {
+      return transitions.data() + offsets[state];
+    }
+    const Successor *end(const size_t state) const {
+      return transitions.data() + offsets[state + 1];
+    }
+  };
   
   enum Direction {
     FORWARD,
@@ -31,49 +74,89 @@ class DijkstraSearch {
 
   static const int INF = numeric_limits<int>::max();
 
+  // Largest transition cost for which the sweep uses a bucket queue
+  // (one bucket per h value) instead of a multimap.
+  static const int MAX_BUCKET_QUEUE_COST = 100;
+
  private:
   
   int bound;
   vector<size_t> queue_init[2];
   function<vector<Successor>(const size_t)> transition_func[2];
-  vector<ParetoFront> pareto[2];
+  TransitionGraph transition_graph[2];
+  bool use_transition_graph[2];
+  int max_transition_cost[2];
+  ParetoFrontTable pareto[2];
 
   bool inits[2];
   bool computed[2][2];
 
-  void expand(size_t state,
-	      ParetoFront::ParetoPair node_pair,
-	      multimap<ParetoFront::ParetoPair, size_t>& lex_queue,
-	      function<vector<Successor>(const size_t)>& transitions,
-	      std::vector<ParetoFront>& pareto_fronts);
-  void expand(size_t state,
-	      ParetoFront::ParetoPair node_pair,
-	      multimap<ParetoFront::ParetoPair, size_t>& lex_queue,
-	      function<vector<Successor>(const size_t)>& transitions,
-	      std::vector<ParetoFront>& pareto_fronts,
-	      std::vector<ParetoFront>& oppoiste_pareto_fronts);
+  bool use_bucket_queue(Direction dir) const;
+
+  template<class LexQueue>
+  void compute(Direction dir, Algorithm alg, LexQueue& lex_queue);
+
+  // Transitions of state, either from the graph or, for function-based
+  // inits, copied into buffer.
+  pair<const Successor *, const Successor *>
+    get_transitions(Direction dir, const size_t state,
+		    vector<Successor>& buffer);
+
+  template<class LexQueue>
+  void expand(ParetoFront::ParetoPair node_pair,
+	      LexQueue& lex_queue,
+	      pair<const Successor *, const Successor *> transitions,
+	      ParetoFrontTable& pareto_fronts);
+  template<class LexQueue>
+  void expand(ParetoFront::ParetoPair node_pair,
+	      LexQueue& lex_queue,
+	      pair<const Successor *, const Successor *> transitions,
+	      ParetoFrontTable& pareto_fronts,
+	      const ParetoFrontTable& opposite_pareto_fronts);
 
  public:
   
   DijkstraSearch(int bound = INF);
   
   bool is_bounded() const;
+  int get_bound() const;
   bool is_init(Direction dir) const;
   bool is_computed(Direction dir, Algorithm alg) const;
 
+  // max_transition_cost is an upper bound on the cost of any transition,
+  // or INF if unknown. Small known costs enable the bucket-based queue.
   void init(Direction dir,
 	    function<vector<Successor>(const size_t)> transition_func,
 	    vector<size_t> queue_init,
-	    size_t max_size);
+	    size_t max_size,
+	    int max_transition_cost = INF);
+  // Number of states and maximum transition cost are taken from the graph.
+  void init(Direction dir,
+	    TransitionGraph transition_graph,
+	    vector<size_t> queue_init);
+  // Frees the transitions of dir, e.g. once all sweeps are done.
+  void release_transitions(Direction dir);
 
   void compute(Direction dir, Algorithm alg);
 
   void clear(Direction dir);
  
   int get_value(Direction dir, const size_t state) const;
-  ParetoFront& get_pareto_front(Direction dir, const size_t state);
+  // Only valid once the sweep in dir has been computed.
+  ParetoFrontView get_pareto_front(Direction dir, const size_t state) const;
+
+  void set_values(Direction dir, ParetoFrontTable new_distances);
 
-  void set_values(Direction dir, vector<ParetoFront>& new_distances);
+  // The fronts computed in dir, e.g. for writing them to disk. Only
+  // valid once the sweep in dir has been computed.
+  const ParetoFrontTable &get_pareto_fronts(Direction dir) const;
+  // Replaces the results in dir by finalised fronts that a sweep with
+  // alg computed before, e.g. loaded from disk.
+  void set_pareto_fronts(Direction dir, ParetoFrontTable fronts,
+			 Algorithm alg);
+  // Moves the fronts computed in dir out, e.g. to keep them once the
+  // search is gone, and clears dir.
+  ParetoFrontTable release_pareto_fronts(Direction dir);
   
 };
 
@@ -0,0 +1,92 @@
+#ifndef DIJKSTRA_SEARCH_LEXICOGRAPHIC_QUEUE_H
+#define DIJKSTRA_SEARCH_LEXICOGRAPHIC_QUEUE_H
+
+#include "pareto_front.h"
+
+#include "../priority_queue.h"
+
+#include <cassert>
+#include <deque>
+#include <map>
+#include <utility>
+
+/*
+  Priority queues over abstract states, ordered lexicographically on
+  their (h, d) pair. Both classes share the same interface so that
+  DijkstraSearch can be instantiated with either of them.
+
+  LexicographicMapQueue works for arbitrary costs, but pays for a heap
+  allocation and an O(log n) rebalance on every push.
+
+  LexicographicBucketQueue keeps one BucketQueue (keyed on d) per h
+  value. Since Dijkstra pops are monotone in h, the current h bucket
+  only moves forward, and pushes and pops are amortised O(1). The
+  number of h buckets grows with the largest h that is pushed, so this
+  should only be used when action costs are small integers.
+
+  Building with -DFORCE_LEXICOGRAPHIC_MAP_QUEUE=TRUE makes DijkstraSearch
+  always use LexicographicMapQueue, so that the PDB construction times
+  printed by the planner can be compared between the two queues.
+*/
+
+class LexicographicMapQueue {
+  std::multimap<ParetoFront::ParetoPair, size_t> queue;
+ public:
+  typedef std::pair<ParetoFront::ParetoPair, size_t> Entry;
+
+  void push(const ParetoFront::ParetoPair pair, const size_t state) {
+    queue.emplace(pair, state);
+  }
+
+  Entry pop() {
+    assert(!queue.empty());
+    auto top = queue.begin();
+    Entry result = *top;
+    queue.erase(top);
+    return result;
+  }
+
+  bool empty() const {
+    return queue.empty();
+  }
+};
+
+
+class LexicographicBucketQueue {
+  // A deque, so that growing the h range never copies the d buckets.
+  std::deque<BucketQueue<size_t>> h_buckets;
+  size_t current_h;
+  size_t num_entries;
+ public:
+  typedef std::pair<ParetoFront::ParetoPair, size_t> Entry;
+
+  LexicographicBucketQueue()
+    : current_h(0), num_entries(0) {
+  }
+
+  void push(const ParetoFront::ParetoPair pair, const size_t state) {
+    assert(pair.h >= 0 && pair.d >= 0);
+    const size_t h = pair.h;
+    if(h >= h_buckets.size())
+      h_buckets.resize(h + 1);
+    else if(h < current_h)
+      current_h = h;
+    h_buckets[h].push(pair.d, state);
+    ++num_entries;
+  }
+
+  Entry pop() {
+    assert(num_entries > 0);
+    while(h_buckets[current_h].empty())
+      ++current_h;
+    --num_entries;
+    const std::pair<int, size_t> top = h_buckets[current_h].pop();
+    return Entry(ParetoFront::ParetoPair(current_h, top.first), top.second);
+  }
+
+  bool empty() const {
+    return num_entries == 0;
+  }
+};
+
+#endif
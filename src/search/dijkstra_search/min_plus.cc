@@ -0,0 +1,103 @@
+#include "min_plus.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MIN_PLUS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace min_plus {
+// Rows shorter than this are not worth the indirect call.
+static const size_t MIN_VECTOR_LENGTH = 8;
+
+static void add_min_scalar(int *dst, const int *src, int offset, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    const int value = src[i] + offset;
+    if (value < dst[i])
+      dst[i] = value;
+  }
+}
+
+#ifdef MIN_PLUS_X86_DISPATCH
+__attribute__((target("sse4.1")))
+static void add_min_sse41(int *dst, const int *src, int offset, size_t n) {
+  const __m128i add = _mm_set1_epi32(offset);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+    d = _mm_min_epi32(d, _mm_add_epi32(s, add));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), d);
+  }
+  add_min_scalar(dst + i, src + i, offset, n - i);
+}
+
+__attribute__((target("avx2")))
+static void add_min_avx2(int *dst, const int *src, int offset, size_t n) {
+  const __m256i add = _mm256_set1_epi32(offset);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+    d = _mm256_min_epi32(d, _mm256_add_epi32(s, add));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), d);
+  }
+  add_min_scalar(dst + i, src + i, offset, n - i);
+}
+#endif
+
+typedef void (*AddMinFunction)(int *, const int *, int, size_t);
+
+struct Implementation {
+  AddMinFunction function;
+  const char *name;
+};
+
+// Fastest implementation first
+static vector<Implementation> get_implementations() {
+  vector<Implementation> implementations;
+#ifdef MIN_PLUS_X86_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    implementations.push_back({add_min_avx2, "avx2"});
+  if (__builtin_cpu_supports("sse4.1"))
+    implementations.push_back({add_min_sse41, "sse4.1"});
+#endif
+  implementations.push_back({add_min_scalar, "scalar"});
+  return implementations;
+}
+
+static Implementation &get_implementation() {
+  static Implementation implementation = get_implementations().front();
+  return implementation;
+}
+
+void add_min(int *dst, const int *src, int offset, size_t n) {
+  if (n < MIN_VECTOR_LENGTH)
+    add_min_scalar(dst, src, offset, n);
+  else
+    get_implementation().function(dst, src, offset, n);
+}
+
+const char *get_implementation_name() {
+  return get_implementation().name;
+}
+
+vector<string> get_available_implementations() {
+  vector<string> names;
+  for (const Implementation &implementation : get_implementations())
+    names.insert(names.begin(), implementation.name);
+  return names;
+}
+
+bool use_implementation(const string &name) {
+  for (const Implementation &implementation : get_implementations()) {
+    if (name == implementation.name) {
+      get_implementation() = implementation;
+      return true;
+    }
+  }
+  return false;
+}
+}
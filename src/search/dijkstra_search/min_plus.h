@@ -0,0 +1,34 @@
+#ifndef DIJKSTRA_SEARCH_MIN_PLUS_H
+#define DIJKSTRA_SEARCH_MIN_PLUS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+  Kernel for the (min, +) convolution used by ParetoFront::merge_additive:
+
+    dst[i] = min(dst[i], src[i] + offset)   for all 0 <= i < n.
+
+  On x86 compilers that support function-level target attributes, an
+  AVX2 or SSE4.1 implementation is selected at runtime depending on
+  the CPU. Otherwise, and for short rows, a scalar loop is used.
+  The caller must ensure that src[i] + offset does not overflow.
+*/
+namespace min_plus {
+void add_min(int *dst, const int *src, int offset, size_t n);
+
+// Name of the implementation chosen for this CPU, for logging.
+const char *get_implementation_name();
+
+// Names of the implementations this CPU supports, "scalar" first.
+std::vector<std::string> get_available_implementations();
+/*
+  Uses the named implementation from now on, for benchmarking the
+  kernels against each other. Returns false if it is not available.
+  Not thread-safe.
+*/
+bool use_implementation(const std::string &name);
+}
+
+#endif
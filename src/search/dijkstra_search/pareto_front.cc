@@ -1,6 +1,7 @@
 #include "pareto_front.h"
 
 #include "dijkstra_search.h"
+#include "min_plus.h"
 
 #include <algorithm>
 #include <cassert>
@@ -23,6 +24,15 @@ ParetoFront::ParetoFront(const std::vector<ParetoFront*>& pfs, const int bound)
   }
 }
 
+ParetoFront::ParetoFront(const ParetoFrontView& view)
+  : pareto_front(view.begin(), view.end())
+{}
+
+ParetoFrontView ParetoFront::view() const {
+  return ParetoFrontView(pareto_front.data(),
+			 pareto_front.data() + pareto_front.size());
+}
+
 void ParetoFront::prune_with_bound(const int bound) {
   for(auto p = pareto_front.begin();
       p != pareto_front.end();
@@ -55,37 +65,78 @@ bool ParetoFront::is_appendable(const ParetoPair p) {
 }
 
 ParetoFront::ParetoPair ParetoFront::get_min_d_pair() const {
-  return (pareto_front.empty()) ?
-    ParetoPair(DijkstraSearch::INF,DijkstraSearch::INF) :
-    *(pareto_front.rbegin());
+  return view().get_min_d_pair();
 }
 
 ParetoFront::ParetoPair ParetoFront::get_min_h_pair() const {
-  return (pareto_front.empty()) ?
-    ParetoPair(DijkstraSearch::INF,DijkstraSearch::INF) :
-    *(pareto_front.begin());
+  return view().get_min_h_pair();
 }
 
 
-ParetoFront::ParetoPair ParetoFront::get_min_pair(
-        const std::function<double(const int h, const int d)>& objective) const
-{
-  auto min_pair = pareto_front.begin();
-  double min_obj = objective(min_pair->h, min_pair->d);
-  for(auto p = std::next(min_pair);
-      p != pareto_front.end();
-      p++) {
-    double obj = objective(p->h, p->d);
-    if(obj < min_obj) {
-      min_obj = obj;
-      min_pair = p;
-    }
-  }
-  return *min_pair;
+
+ParetoFront::ParetoPair ParetoFrontView::get_min_d_pair() const {
+  return empty() ?
+    ParetoFront::ParetoPair(DijkstraSearch::INF,DijkstraSearch::INF) :
+    (*this)[length - 1];
+}
+
+ParetoFront::ParetoPair ParetoFrontView::get_min_h_pair() const {
+  return empty() ?
+    ParetoFront::ParetoPair(DijkstraSearch::INF,DijkstraSearch::INF) :
+    (*this)[0];
+}
+
+
+template<class Pair>
+static size_t count_pairs_within(const Pair *first, const Pair *last,
+				 const int budget) {
+  return std::upper_bound(first, last, budget,
+			  [](const int b, const Pair &p) {
+			    return b < (int) p.h;
+			  }) - first;
+}
+
+size_t ParetoFrontView::count_within(const int budget) const {
+  if(budget < 0)
+    return 0;
+  if(compact)
+    return count_pairs_within(get_compact_pairs(),
+			      get_compact_pairs() + length, budget);
+  return count_pairs_within(get_pairs(), get_pairs() + length, budget);
+}
+
+ParetoFront::ParetoPair ParetoFrontView::get_min_d_pair(const int budget) const {
+  const size_t count = count_within(budget);
+  return count == 0 ?
+    ParetoFront::ParetoPair(DijkstraSearch::INF,DijkstraSearch::INF) :
+    (*this)[count - 1];
+}
+
+ParetoFront::ParetoPair ParetoFrontView::get_min_h_pair(const int budget) const {
+  if(empty() || (*this)[0].h > budget)
+    return ParetoFront::ParetoPair(DijkstraSearch::INF,DijkstraSearch::INF);
+  return (*this)[0];
 }
 
 void ParetoFront::merge_additive(const ParetoFront& other, const int bound) {
-  if(pareto_front.empty() || other.pareto_front.empty()) {
+  merge_additive(other.view(), bound);
+}
+
+void ParetoFront::merge_additive(const ParetoFrontView& other, const int bound) {
+  // Dispatch on the encoding once, rather than per pair.
+  if(other.is_compact()) {
+    merge_additive(other.get_compact_pairs(),
+		   other.get_compact_pairs() + other.size(), bound);
+  } else {
+    merge_additive(other.get_pairs(),
+		   other.get_pairs() + other.size(), bound);
+  }
+}
+
+template<class Pair>
+void ParetoFront::merge_additive(const Pair *other_begin, const Pair *other_end,
+				 const int bound) {
+  if(pareto_front.empty() || other_begin == other_end) {
     pareto_front.clear();
     return;
   }
@@ -94,7 +145,8 @@ void ParetoFront::merge_additive(const ParetoFront& other, const int bound) {
   const ParetoPair min_h_pair = get_min_h_pair();
   if(pareto_front.size() == 1) {
     pareto_front.clear();
-    for(auto p : other.pareto_front) {
+    for(const Pair *other_p = other_begin; other_p != other_end; other_p++) {
+      ParetoPair p = *other_p;
       p += min_h_pair;
       if(p.h > bound) break;
       pareto_front.push_back(p);
@@ -102,8 +154,8 @@ void ParetoFront::merge_additive(const ParetoFront& other, const int bound) {
     return;
   }
   
-  const ParetoPair other_min_h_pair = other.get_min_h_pair();
-  if(other.pareto_front.size() == 1) {
+  const ParetoPair other_min_h_pair = *other_begin;
+  if(other_end - other_begin == 1) {
     for(auto a = pareto_front.begin();
 	a != pareto_front.end();
 	a++) {
@@ -117,28 +169,35 @@ void ParetoFront::merge_additive(const ParetoFront& other, const int bound) {
   }
 
   //Perform bucketed additive merge 
-  const int mind = get_min_d_pair().d + other.get_min_d_pair().d;
+  // Sums above bound are never kept, so the buckets and the gaps in the
+  // dense copy of other below can use out_of_bound as infinity. The
+  // bound is capped so that out_of_bound plus any h cannot overflow.
+  const int out_of_bound = std::min(bound, MAX_MERGE_BOUND) + 1;
+  const int mind = get_min_d_pair().d + ParetoPair(*(other_end - 1)).d;
   const int maxd = get_min_h_pair().d + other_min_h_pair.d;
   const size_t minh_size = ((maxd - mind)+1);
   int *minh = (int *) alloca(sizeof(int) * minh_size);
-  std::fill(minh, minh + minh_size, bound+1);
+  std::fill(minh, minh + minh_size, out_of_bound);
 
-  int newh, newd;
-  for(const auto a : pareto_front) {
-    if(a.h + other_min_h_pair.h > bound) break;
-    for(const auto b : other.pareto_front) {
-      newh = a.h + b.h;
-      newd = a.d + b.d;
-      
-      if(newh > bound) break;
-      
-      if(newh < minh[newd-mind])
-  	minh[newd-mind] = newh;
+  if(other_end - other_begin < DENSE_MERGE_MIN_SIZE) {
+    for(const auto a : pareto_front) {
+      if(a.h + other_min_h_pair.h > bound) break;
+      for(const Pair *other_p = other_begin; other_p != other_end; other_p++) {
+	const ParetoPair b = *other_p;
+	const int newh = a.h + b.h;
+	if(newh > bound) break;
+	int &bucket = minh[a.d + b.d - mind];
+	if(newh < bucket)
+	  bucket = newh;
+      }
     }
+  } else {
+    merge_additive_dense(other_begin, other_end, bound, out_of_bound,
+			 mind, minh);
   }
 
   pareto_front.clear();
-  int curminh = bound+1;
+  int curminh = out_of_bound;
   for(size_t d = 0; d < minh_size; d++) {
     if(minh[d] < curminh) {
       curminh = minh[d];
@@ -147,3 +206,35 @@ void ParetoFront::merge_additive(const ParetoFront& other, const int bound) {
   }
   std::reverse(pareto_front.begin(), pareto_front.end());
 }
+
+template<class Pair>
+void ParetoFront::merge_additive_dense(const Pair *other_begin,
+				       const Pair *other_end,
+				       const int bound, const int out_of_bound,
+				       const int mind, int *minh) const {
+  const ParetoPair other_min_h_pair = *other_begin;
+
+  // Lay other out densely over its d range, so that each row of the
+  // cross product is a (min, +) of two contiguous arrays.
+  const int other_mind = ParetoPair(*(other_end - 1)).d;
+  const size_t other_size = (other_min_h_pair.d - other_mind) + 1;
+  int *other_h = (int *) alloca(sizeof(int) * other_size);
+  std::fill(other_h, other_h + other_size, out_of_bound);
+  for(const Pair *other_p = other_begin; other_p != other_end; other_p++) {
+    const ParetoPair b = *other_p;
+    if(b.h >= out_of_bound) break;
+    other_h[b.d - other_mind] = b.h;
+  }
+
+  // Pairs of other with h > bound - a.h form a suffix (lowest d first
+  // in the dense layout), which shrinks as a.h grows.
+  const Pair *other_last = other_end;
+  for(const auto a : pareto_front) {
+    if(a.h + other_min_h_pair.h > bound) break;
+    while(a.h + ParetoPair(*(other_last - 1)).h > bound)
+      --other_last;
+    const size_t first = ParetoPair(*(other_last - 1)).d - other_mind;
+    min_plus::add_min(minh + (a.d + other_mind - mind) + first,
+		      other_h + first, a.h, other_size - first);
+  }
+}
@@ -4,10 +4,14 @@
 //#include <map>
 #include <functional>
 #include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <vector>
 #include <list>
 #include <utility>
 
+class ParetoFrontView;
+
 class ParetoFront {
   
  public:
@@ -44,15 +48,44 @@ class ParetoFront {
     }
     
   };
+
+  /*
+    Half-size pair for tables whose h and d values all fit in 16 bits.
+  */
+  struct CompactParetoPair {
+    static const int MAX_VALUE = UINT16_MAX;
+    uint16_t h;
+    uint16_t d;
+    CompactParetoPair(const ParetoPair p) : h(p.h), d(p.d) {}
+    operator ParetoPair() const {
+      return ParetoPair(h, d);
+    }
+  };
   
   
  private:
   std::vector<ParetoPair> pareto_front;
 
+  // Bounds above this are treated as this in merge_additive.
+  static const int MAX_MERGE_BOUND = (1 << 30) - 1;
+
+  // Smaller fronts are merged pair by pair rather than densely.
+  static const int DENSE_MERGE_MIN_SIZE = 8;
+
+  template<class Pair>
+  void merge_additive(const Pair *other_begin, const Pair *other_end,
+		      const int bound);
+  template<class Pair>
+  void merge_additive_dense(const Pair *other_begin, const Pair *other_end,
+			    const int bound, const int out_of_bound,
+			    const int mind, int *minh) const;
+
 public:
   ParetoFront();
 
   ParetoFront(const std::vector<ParetoFront*>& pfs, const int bound);
+
+  explicit ParetoFront(const ParetoFrontView& view);
   
   ~ParetoFront() = default;
 
@@ -70,16 +103,128 @@ public:
   // Returns h*
   ParetoPair get_min_h_pair() const;
 
-  // Returns the minimum pair according to the comparison function
-  ParetoPair get_min_pair(const std::function<double(const int h, const int d)>& objective) const;
+  // Returns the minimum pair according to the objective, a callable
+  // double(int h, int d). The first minimum wins ties.
+  template<class Objective>
+  ParetoPair get_min_pair(const Objective& objective) const;
 
   bool empty() const {
     return pareto_front.empty();
   }
 
+  size_t size() const {
+    return pareto_front.size();
+  }
+
+  ParetoFrontView view() const;
+
   void merge_additive(const ParetoFront& other, const int bound);
+  void merge_additive(const ParetoFrontView& other, const int bound);
+
+};
+
+
+/*
+  Read-only view of a Pareto front stored elsewhere, e.g. in a
+  ParetoFrontTable. It is only valid as long as the storage it points
+  into is not modified. The pairs are stored either as ParetoPairs or
+  as CompactParetoPairs; iteration yields ParetoPairs in both cases.
+*/
+class ParetoFrontView {
+  const void *data;
+  size_t length;
+  bool compact;
+public:
+  class const_iterator
+    : public std::iterator<std::forward_iterator_tag,
+			   ParetoFront::ParetoPair> {
+    const ParetoFrontView *view;
+    size_t pos;
+  public:
+    const_iterator(const ParetoFrontView *view, size_t pos)
+      : view(view), pos(pos) {}
+    ParetoFront::ParetoPair operator*() const {
+      return (*view)[pos];
+    }
+    const_iterator &operator++() {
+      ++pos;
+      return *this;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return pos != other.pos;
+    }
+    bool operator==(const const_iterator &other) const {
+      return pos == other.pos;
+    }
+  };
+
+  ParetoFrontView(const ParetoFront::ParetoPair *first,
+		  const ParetoFront::ParetoPair *last)
+    : data(first), length(last - first), compact(false) {}
+  ParetoFrontView(const ParetoFront::CompactParetoPair *first,
+		  const ParetoFront::CompactParetoPair *last)
+    : data(first), length(last - first), compact(true) {}
+
+  bool is_compact() const {
+    return compact;
+  }
+  const ParetoFront::ParetoPair *get_pairs() const {
+    return static_cast<const ParetoFront::ParetoPair *>(data);
+  }
+  const ParetoFront::CompactParetoPair *get_compact_pairs() const {
+    return static_cast<const ParetoFront::CompactParetoPair *>(data);
+  }
 
+  ParetoFront::ParetoPair operator[](size_t i) const {
+    if(compact)
+      return get_compact_pairs()[i];
+    return get_pairs()[i];
+  }
+  const_iterator begin() const {
+    return const_iterator(this, 0);
+  }
+  const_iterator end() const {
+    return const_iterator(this, length);
+  }
+  size_t size() const {
+    return length;
+  }
+  bool empty() const {
+    return length == 0;
+  }
+
+  ParetoFront::ParetoPair get_min_d_pair() const;
+  ParetoFront::ParetoPair get_min_h_pair() const;
+  template<class Objective>
+  ParetoFront::ParetoPair get_min_pair(const Objective& objective) const;
+
+  // Fronts are sorted by increasing h and decreasing d, so they are
+  // step functions from a cost budget to the best pair within it.
+  // These return the number of pairs with h <= budget (by binary
+  // search) and the min-d/min-h pair among them, or (INF, INF).
+  size_t count_within(const int budget) const;
+  ParetoFront::ParetoPair get_min_d_pair(const int budget) const;
+  ParetoFront::ParetoPair get_min_h_pair(const int budget) const;
 };
 
+template<class Objective>
+ParetoFront::ParetoPair ParetoFront::get_min_pair(const Objective& objective) const {
+  return view().get_min_pair(objective);
+}
+
+template<class Objective>
+ParetoFront::ParetoPair ParetoFrontView::get_min_pair(const Objective& objective) const {
+  ParetoFront::ParetoPair min_pair = (*this)[0];
+  double min_obj = objective(min_pair.h, min_pair.d);
+  for(size_t i = 1; i < length; i++) {
+    const ParetoFront::ParetoPair p = (*this)[i];
+    double obj = objective(p.h, p.d);
+    if(obj < min_obj) {
+      min_obj = obj;
+      min_pair = p;
+    }
+  }
+  return min_pair;
+}
 
 #endif
@@ -0,0 +1,253 @@
+#include "pareto_front_table.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+using namespace std;
+
+static const ParetoFront::ParetoPair EMPTY_PAIR(numeric_limits<int>::max(),
+						numeric_limits<int>::max());
+
+ParetoFrontTable::ParetoFrontTable()
+  : num_states(0), finalised(false), compact(false),
+    front_offsets(nullptr), front_pairs(nullptr),
+    front_compact_pairs(nullptr) {
+}
+
+void ParetoFrontTable::point_to_vectors() {
+  front_offsets = offsets.data();
+  front_pairs = pairs.data();
+  front_compact_pairs = compact_pairs.data();
+}
+
+void ParetoFrontTable::unmap() {
+  if(!mapping)
+    return;
+  const size_t num_pairs = front_offsets[num_states];
+  offsets.assign(front_offsets, front_offsets + num_states + 1);
+  if(compact)
+    compact_pairs.assign(front_compact_pairs, front_compact_pairs + num_pairs);
+  else
+    pairs.assign(front_pairs, front_pairs + num_pairs);
+  mapping.reset();
+  point_to_vectors();
+}
+
+void ParetoFrontTable::resize(size_t num_states) {
+  if(num_states == this->num_states)
+    return;
+  if(finalised) {
+    unmap();
+    offsets.resize(num_states + 1, offsets.back());
+    if(compact)
+      compact_pairs.resize(offsets.back(), EMPTY_PAIR);
+    else
+      pairs.resize(offsets.back(), EMPTY_PAIR);
+    point_to_vectors();
+  } else {
+    if(num_states < this->num_states) {
+      size_t kept = 0;
+      for(const LogEntry &entry : log) {
+	if(entry.state < num_states)
+	  log[kept++] = entry;
+      }
+      log.erase(log.begin() + kept, log.end());
+    }
+    min_h_pairs.resize(num_states, EMPTY_PAIR);
+    min_d_pairs.resize(num_states, EMPTY_PAIR);
+  }
+  this->num_states = num_states;
+}
+
+void ParetoFrontTable::clear() {
+  num_states = 0;
+  finalised = false;
+  vector<size_t>().swap(offsets);
+  vector<ParetoFront::ParetoPair>().swap(pairs);
+  vector<ParetoFront::CompactParetoPair>().swap(compact_pairs);
+  compact = false;
+  mapping.reset();
+  point_to_vectors();
+  vector<LogEntry>().swap(log);
+  vector<ParetoFront::ParetoPair>().swap(min_h_pairs);
+  vector<ParetoFront::ParetoPair>().swap(min_d_pairs);
+}
+
+void ParetoFrontTable::finalise() {
+  if(finalised)
+    return;
+
+  // Counting sort of the log by state. The sort is stable, so each
+  // front stays in order of increasing h.
+  offsets.assign(num_states + 1, 0);
+  for(const LogEntry &entry : log)
+    ++offsets[entry.state + 1];
+  for(size_t i = 1; i <= num_states; i++)
+    offsets[i] += offsets[i - 1];
+  pairs.assign(log.size(), EMPTY_PAIR);
+  {
+    vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for(const LogEntry &entry : log)
+      pairs[next[entry.state]++] = entry.pair;
+  }
+  vector<LogEntry>().swap(log);
+
+  // append_pair replaces the last pair of a front if it has the same
+  // h, which shows up as consecutive log entries. Keep only the last.
+  size_t kept = 0;
+  for(size_t i = 0; i < num_states; i++) {
+    const size_t begin = offsets[i];
+    const size_t end = offsets[i + 1];
+    offsets[i] = kept;
+    for(size_t j = begin; j < end; j++) {
+      if(kept > offsets[i] && pairs[kept - 1].h == pairs[j].h)
+	pairs[kept - 1] = pairs[j];
+      else
+	pairs[kept++] = pairs[j];
+    }
+  }
+  offsets[num_states] = kept;
+  pairs.resize(kept, EMPTY_PAIR);
+
+  compact = true;
+  for(const ParetoFront::ParetoPair &p : pairs) {
+    if(p.h > ParetoFront::CompactParetoPair::MAX_VALUE ||
+       p.d > ParetoFront::CompactParetoPair::MAX_VALUE) {
+      compact = false;
+      break;
+    }
+  }
+  if(compact) {
+    compact_pairs.assign(pairs.begin(), pairs.end());
+    vector<ParetoFront::ParetoPair>().swap(pairs);
+  } else {
+    pairs.shrink_to_fit();
+  }
+
+  vector<ParetoFront::ParetoPair>().swap(min_h_pairs);
+  vector<ParetoFront::ParetoPair>().swap(min_d_pairs);
+  point_to_vectors();
+  finalised = true;
+}
+
+void ParetoFrontTable::reopen() {
+  if(!finalised)
+    return;
+
+  min_h_pairs.assign(num_states, EMPTY_PAIR);
+  min_d_pairs.assign(num_states, EMPTY_PAIR);
+  log.reserve(front_offsets[num_states]);
+  for(size_t i = 0; i < num_states; i++) {
+    const ParetoFrontView front = get_front(i);
+    if(front.empty())
+      continue;
+    min_h_pairs[i] = front.get_min_h_pair();
+    min_d_pairs[i] = front.get_min_d_pair();
+    for(const ParetoFront::ParetoPair &p : front)
+      log.emplace_back(i, p);
+  }
+
+  vector<size_t>().swap(offsets);
+  vector<ParetoFront::ParetoPair>().swap(pairs);
+  vector<ParetoFront::CompactParetoPair>().swap(compact_pairs);
+  compact = false;
+  mapping.reset();
+  point_to_vectors();
+  finalised = false;
+}
+
+/*
+  Layout of a written table: the number of states, the number of pairs
+  and whether the pairs are compact (each as uint64_t), the offsets
+  (num_states + 1 size_ts) and the pairs, padded to a multiple of 8
+  bytes.
+*/
+static const size_t HEADER_SIZE = 3 * sizeof(uint64_t);
+
+static size_t get_padding(size_t bytes) {
+  return (8 - bytes % 8) % 8;
+}
+
+void ParetoFrontTable::write(ostream &out) const {
+  assert(finalised);
+  const uint64_t header[3] = {num_states, front_offsets[num_states], compact};
+  out.write(reinterpret_cast<const char *>(header), HEADER_SIZE);
+  out.write(reinterpret_cast<const char *>(front_offsets),
+	    (num_states + 1) * sizeof(size_t));
+  size_t pair_bytes;
+  if(compact) {
+    pair_bytes = header[1] * sizeof(ParetoFront::CompactParetoPair);
+    out.write(reinterpret_cast<const char *>(front_compact_pairs), pair_bytes);
+  } else {
+    pair_bytes = header[1] * sizeof(ParetoFront::ParetoPair);
+    out.write(reinterpret_cast<const char *>(front_pairs), pair_bytes);
+  }
+  const char padding[8] = {0};
+  out.write(padding, get_padding(pair_bytes));
+}
+
+bool ParetoFrontTable::map(const char *data, size_t size,
+			   shared_ptr<const void> owner) {
+  if(size < HEADER_SIZE)
+    return false;
+  uint64_t header[3];
+  memcpy(header, data, HEADER_SIZE);
+  const size_t new_num_states = header[0];
+  const size_t num_pairs = header[1];
+  const bool new_compact = header[2];
+  // Guards the size computations below against corrupt headers.
+  if(new_num_states >= size / sizeof(size_t) || num_pairs > size)
+    return false;
+  const size_t offset_bytes = (new_num_states + 1) * sizeof(size_t);
+  const size_t pair_bytes = num_pairs * (new_compact ?
+					 sizeof(ParetoFront::CompactParetoPair) :
+					 sizeof(ParetoFront::ParetoPair));
+  if(size != HEADER_SIZE + offset_bytes + pair_bytes + get_padding(pair_bytes))
+    return false;
+  const size_t *new_offsets =
+    reinterpret_cast<const size_t *>(data + HEADER_SIZE);
+  if(new_offsets[new_num_states] != num_pairs)
+    return false;
+
+  clear();
+  num_states = new_num_states;
+  compact = new_compact;
+  front_offsets = new_offsets;
+  const char *pair_data = data + HEADER_SIZE + offset_bytes;
+  if(compact)
+    front_compact_pairs =
+      reinterpret_cast<const ParetoFront::CompactParetoPair *>(pair_data);
+  else
+    front_pairs = reinterpret_cast<const ParetoFront::ParetoPair *>(pair_data);
+  mapping = move(owner);
+  finalised = true;
+  return true;
+}
+
+bool ParetoFrontTable::is_appendable(size_t state,
+				     const ParetoFront::ParetoPair p) const {
+  assert(!finalised && state < num_states);
+  const ParetoFront::ParetoPair min_d = min_d_pairs[state];
+  if(min_d.h == EMPTY_PAIR.h)
+    return true;
+  return min_d.d > p.d && min_d.h <= p.h;
+}
+
+bool ParetoFrontTable::append_pair(size_t state,
+				   const ParetoFront::ParetoPair p) {
+  if(!is_appendable(state, p))
+    return false;
+  if(min_h_pairs[state].h == EMPTY_PAIR.h)
+    min_h_pairs[state] = p;
+  else if(min_h_pairs[state].h == p.h)
+    min_h_pairs[state].d = p.d;
+  min_d_pairs[state] = p;
+  log.emplace_back(state, p);
+  return true;
+}
+
+void ParetoFrontTable::set_front(size_t state, const ParetoFrontView& front) {
+  for(const ParetoFront::ParetoPair &p : front)
+    append_pair(state, p);
+}
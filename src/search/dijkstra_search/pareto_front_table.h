@@ -0,0 +1,130 @@
+#ifndef DIJKSTRA_SEARCH_PARETO_FRONT_TABLE_H
+#define DIJKSTRA_SEARCH_PARETO_FRONT_TABLE_H
+
+#include "pareto_front.h"
+
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+/*
+  The Pareto fronts of all abstract states, stored in a single arena.
+
+  While a Dijkstra sweep runs, pairs can only be appended to the back
+  of a front (in order of increasing h). The table keeps a log of
+  the appended pairs together with the first and last pair of every
+  front, which is all the sweep needs to look at, so no per-state
+  allocation is made.
+
+  finalise() sorts the log by state into one contiguous array in
+  which front i is the slice [offsets[i], offsets[i+1]). If all h and
+  d values fit in 16 bits, the array uses CompactParetoPairs, which
+  halves its size. Fronts can then be read as ParetoFrontViews.
+  reopen() goes back to the building phase, e.g. when a Pareto sweep
+  continues from the result of an ordinary one.
+
+  A finalised table can be written to a stream with write() and used
+  in place from memory with map(), e.g. from a memory-mapped file, so
+  loading it copies nothing.
+*/
+class ParetoFrontTable {
+  struct LogEntry {
+    size_t state;
+    ParetoFront::ParetoPair pair;
+  LogEntry(size_t state, ParetoFront::ParetoPair pair)
+  : state(state), pair(pair) {}
+  };
+
+  size_t num_states;
+  bool finalised;
+
+  // Finalised fronts. Only one of pairs and compact_pairs is used.
+  std::vector<size_t> offsets;
+  std::vector<ParetoFront::ParetoPair> pairs;
+  std::vector<ParetoFront::CompactParetoPair> compact_pairs;
+  bool compact;
+
+  // The finalised fronts are read through these, which point either
+  // into the vectors above or into mapped memory kept alive by
+  // mapping.
+  const size_t *front_offsets;
+  const ParetoFront::ParetoPair *front_pairs;
+  const ParetoFront::CompactParetoPair *front_compact_pairs;
+  std::shared_ptr<const void> mapping;
+
+  void point_to_vectors();
+  // Copies mapped fronts into the vectors.
+  void unmap();
+
+  // Fronts under construction.
+  std::vector<LogEntry> log;
+  std::vector<ParetoFront::ParetoPair> min_h_pairs;
+  std::vector<ParetoFront::ParetoPair> min_d_pairs;
+
+public:
+  ParetoFrontTable();
+  ParetoFrontTable(const ParetoFrontTable &) = delete;
+  ParetoFrontTable &operator=(const ParetoFrontTable &) = delete;
+  ParetoFrontTable(ParetoFrontTable &&) = default;
+  ParetoFrontTable &operator=(ParetoFrontTable &&) = default;
+
+  // Grows or shrinks the table, keeping the fronts of the first
+  // min(size(), num_states) states. New fronts are empty.
+  void resize(size_t num_states);
+  void clear();
+
+  void finalise();
+  void reopen();
+
+  // Only once finalised. The data is in the byte order and type sizes
+  // of this machine.
+  void write(std::ostream &out) const;
+  /*
+    Uses the finalised fronts written by write() at data, which must
+    be aligned to 8 bytes, in place. owner keeps the memory alive
+    while the table uses it. Returns false and leaves the table
+    unchanged if size does not match the data.
+  */
+  bool map(const char *data, size_t size, std::shared_ptr<const void> owner);
+
+  bool is_finalised() const {
+    return finalised;
+  }
+
+  bool is_compact() const {
+    return finalised && compact;
+  }
+
+  size_t size() const {
+    return num_states;
+  }
+
+  // Only while building.
+  bool append_pair(size_t state, const ParetoFront::ParetoPair p);
+  bool is_appendable(size_t state, const ParetoFront::ParetoPair p) const;
+  void set_front(size_t state, const ParetoFrontView& front);
+
+  bool empty(size_t state) const {
+    return get_min_h_pair(state).h == std::numeric_limits<int>::max();
+  }
+  ParetoFront::ParetoPair get_min_h_pair(size_t state) const {
+    assert(state < num_states);
+    if(!finalised)
+      return min_h_pairs[state];
+    return get_front(state).get_min_h_pair();
+  }
+
+  // Only once finalised.
+  ParetoFrontView get_front(size_t state) const {
+    assert(finalised && state < num_states);
+    if(compact)
+      return ParetoFrontView(front_compact_pairs + front_offsets[state],
+			     front_compact_pairs + front_offsets[state + 1]);
+    return ParetoFrontView(front_pairs + front_offsets[state],
+			   front_pairs + front_offsets[state + 1]);
+  }
+};
+
+#endif
@@ -13,30 +13,34 @@ EvaluationContext::EvaluationContext(
     const HeuristicCache &cache, int g_value, bool is_preferred,
     SearchStatistics *statistics, bool calculate_preferred,
     int bound,
-    int u_value)
+    int u_value,
+    DepthHistogram *depth_histogram)
     : cache(cache),
       g_value(g_value),
       preferred(is_preferred),
       statistics(statistics),
       calculate_preferred(calculate_preferred),
       bound(bound),
-      u_value(u_value) {
+      u_value(u_value),
+      depth_histogram(depth_histogram) {
 }
 
 EvaluationContext::EvaluationContext(
     const GlobalState &state, int g_value, bool is_preferred,
     SearchStatistics *statistics, bool calculate_preferred,
     int bound,
-    int u_value)
-  : EvaluationContext(HeuristicCache(state), g_value, is_preferred, statistics, calculate_preferred, bound, u_value){
+    int u_value,
+    DepthHistogram *depth_histogram)
+  : EvaluationContext(HeuristicCache(state), g_value, is_preferred, statistics, calculate_preferred, bound, u_value, depth_histogram){
 }
 
 EvaluationContext::EvaluationContext(
     const GlobalState &state,
     SearchStatistics *statistics, bool calculate_preferred,
     int bound,
-    int u_value)
-  : EvaluationContext(HeuristicCache(state), INVALID, false, statistics, calculate_preferred, bound, u_value) {
+    int u_value,
+    DepthHistogram *depth_histogram)
+  : EvaluationContext(HeuristicCache(state), INVALID, false, statistics, calculate_preferred, bound, u_value, depth_histogram) {
 }
 
 const EvaluationResult &EvaluationContext::get_result(ScalarEvaluator *heur) {
@@ -77,6 +81,10 @@ int EvaluationContext::get_bound() const {
     return bound;
 }
 
+DepthHistogram *EvaluationContext::get_depth_histogram() const {
+    return depth_histogram;
+}
+
 bool EvaluationContext::is_preferred() const {
     assert(g_value != INVALID);
     return preferred;
@@ -6,6 +6,7 @@
 
 #include <unordered_map>
 
+class DepthHistogram;
 class GlobalOperator;
 class GlobalState;
 class ScalarEvaluator;
@@ -55,6 +56,7 @@ class EvaluationContext {
 
     int bound;
     int u_value;
+    DepthHistogram *depth_histogram;
     
     static const int INVALID = -1;
 
@@ -68,7 +70,8 @@ public:
     EvaluationContext(
         const HeuristicCache &cache, int g_value, bool is_preferred,
         SearchStatistics *statistics, bool calculate_preferred = false,
-        int bound = EvaluationResult::INFTY, int u_value = INVALID);
+        int bound = EvaluationResult::INFTY, int u_value = INVALID,
+        DepthHistogram *depth_histogram = nullptr);
     /*
       Create new heuristic cache for caching heuristic values. Used for example
       by eager search.
@@ -76,7 +79,8 @@ public:
     EvaluationContext(
         const GlobalState &state, int g_value, bool is_preferred,
         SearchStatistics *statistics, bool calculate_preferred = false,
-        int bound = EvaluationResult::INFTY, int u_value = INVALID);
+        int bound = EvaluationResult::INFTY, int u_value = INVALID,
+        DepthHistogram *depth_histogram = nullptr);
     /*
       Use the following constructor when you don't care about g values,
       preferredness (and statistics), e.g. when sampling states for heuristics.
@@ -93,7 +97,8 @@ public:
         const GlobalState &state,
         SearchStatistics *statistics = nullptr,
 	bool calculate_preferred = false,
-        int bound = EvaluationResult::INFTY, int u_value = INVALID);
+        int bound = EvaluationResult::INFTY, int u_value = INVALID,
+        DepthHistogram *depth_histogram = nullptr);
 
     ~EvaluationContext() = default;
 
@@ -103,6 +108,8 @@ public:
     int get_g_value() const;
     int get_u_value() const;
     int get_bound() const;
+    // Per-search depth statistics, or nullptr if the engine keeps none.
+    DepthHistogram *get_depth_histogram() const;
     bool is_preferred() const;
 
     /*
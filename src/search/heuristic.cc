@@ -79,7 +79,7 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
     } else {
-      heuristic = compute_heuristic(state, eval_context.get_g_value(), eval_context.get_bound(), eval_context.get_u_value());
+      heuristic = compute_heuristic(state, eval_context.get_g_value(), eval_context.get_bound(), eval_context.get_u_value(), eval_context.get_depth_histogram());
         if (cache_h_values) {
             heuristic_cache[state] = HEntry(heuristic, false);
         }
@@ -114,6 +114,23 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     return result;
 }
 
+EvaluationResult Heuristic::compute_result_concurrently(
+    const EvaluationContext &eval_context) {
+    assert(supports_concurrent_evaluation());
+    assert(!eval_context.get_calculate_preferred());
+    int heuristic = compute_heuristic(
+        eval_context.get_state(), eval_context.get_g_value(),
+        eval_context.get_bound(), eval_context.get_u_value(),
+        eval_context.get_depth_histogram());
+    assert(heuristic == DEAD_END || heuristic >= 0);
+
+    EvaluationResult result;
+    result.set_count_evaluation(true);
+    result.set_h_value(
+        heuristic == DEAD_END ? EvaluationResult::INFTY : heuristic);
+    return result;
+}
+
 string Heuristic::get_description() const {
     return description;
 }
@@ -10,6 +10,7 @@
 #include <memory>
 #include <vector>
 
+class DepthHistogram;
 class GlobalOperator;
 class GlobalState;
 class TaskProxy;
@@ -72,14 +73,27 @@ protected:
     // depending on the g-level and bound.
     // These heuristics must make sure that the heuristic cache is disabled,
     // or otherwise altered so that it is indexed via (state, g, bound)
-    virtual int compute_heuristic(const GlobalState &state, const int g, const int bound, int u)
+    // u is the depth of the node and depth_histogram the depth statistics
+    // of the search, which may be nullptr.
+    virtual int compute_heuristic(const GlobalState &state, const int g, const int bound, int u,
+				  DepthHistogram *depth_histogram)
     {
       (void)g;
       (void)bound;
       (void)u;
+      (void)depth_histogram;
       return compute_heuristic(state);
     }
 
+    /*
+      True if the bounded compute_heuristic above may run for several
+      states at once in different threads, e.g. because it only reads
+      the heuristic's data.
+    */
+    virtual bool is_reentrant() const {
+        return false;
+    }
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
@@ -114,6 +128,24 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
 
+    /*
+      True if compute_result_concurrently may be used. This requires a
+      reentrant heuristic that does not cache its estimates, because the
+      cache is shared by all states.
+    */
+    bool supports_concurrent_evaluation() const {
+        return is_reentrant() && !cache_h_values;
+    }
+
+    /*
+      Computes the result like compute_result, but may be called for
+      several states at once in different threads if
+      supports_concurrent_evaluation() holds. No preferred operators
+      are computed.
+    */
+    EvaluationResult compute_result_concurrently(
+        const EvaluationContext &eval_context);
+
     std::string get_description() const;
     bool is_h_dirty(GlobalState &state) {
         return heuristic_cache[state].dirty;
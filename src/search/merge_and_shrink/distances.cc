@@ -6,6 +6,7 @@
 #include "../priority_queue.h"
 #include "../dijkstra_search/dijkstra_search.h"
 #include "../dijkstra_search/pareto_front.h"
+#include "../dijkstra_search/pareto_front_table.h"
 
 #include <cassert>
 #include <deque>
@@ -40,41 +41,44 @@ namespace merge_and_shrink {
     return transition_system.get_size();
   }
 
-  function<vector< DijkstraSearch::Successor>(const size_t state) > Distances::get_successors() const {
-    vector<vector<DijkstraSearch::Successor>> forward_graph(get_num_states());
+  DijkstraSearch::TransitionGraph Distances::build_transition_graph(bool backward) const {
+    // Transitions are grouped by label, so count the transitions of
+    // each state first and fill the graph in a second pass.
+    DijkstraSearch::TransitionGraph graph(get_num_states());
     for (const GroupAndTransitions &gat : transition_system) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        int cost = label_group.get_cost();
-        for (const Transition &transition : transitions) {
-             forward_graph[transition.src].push_back(
-                DijkstraSearch::Successor(transition.target, cost));
+        for (const Transition &transition : gat.transitions) {
+            graph.count_transition(backward ? transition.target : transition.src);
         }
     }
-    return [forward_graph] (const size_t state) {
-      return forward_graph[state];
-    };
-  }
-  function<vector< DijkstraSearch::Successor>(const size_t state) > Distances::get_predecessors() const {
-    vector<vector<DijkstraSearch::Successor>> backward_graph(get_num_states());
+    graph.allocate();
     for (const GroupAndTransitions &gat : transition_system) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        int cost = label_group.get_cost();
-        for (const Transition &transition : transitions) {
-	     backward_graph[transition.target].push_back(
-                DijkstraSearch::Successor(transition.src, cost));
+        int cost = gat.label_group.get_cost();
+        for (const Transition &transition : gat.transitions) {
+	    if (backward)
+	        graph.set_transition(transition.target, transition.src, cost);
+	    else
+	        graph.set_transition(transition.src, transition.target, cost);
         }
     }
-    return [backward_graph] (const size_t state) {
-      return backward_graph[state];
-    };
+    return graph;
+  }
+
+  DijkstraSearch::TransitionGraph Distances::get_successors() const {
+    return build_transition_graph(false);
+  }
+  DijkstraSearch::TransitionGraph Distances::get_predecessors() const {
+    return build_transition_graph(true);
   }
 
-  ParetoFront&  Distances::get_backward_pareto_front(const size_t state) {
+  ParetoFrontView Distances::get_backward_pareto_front(const size_t state) const {
     return dijkstra_search.get_pareto_front(DijkstraSearch::BACKWARD, state);
   }
 
+  ParetoFrontTable Distances::release_backward_pareto_fronts() {
+    assert(are_backward_pareto_fronts_computed());
+    return dijkstra_search.release_pareto_fronts(DijkstraSearch::BACKWARD);
+  }
+
   bool Distances::are_distances_computed() const {
     return dijkstra_search.is_computed(DijkstraSearch::FORWARD, DijkstraSearch::ORDINARY) &&
       dijkstra_search.is_computed(DijkstraSearch::BACKWARD, DijkstraSearch::ORDINARY);
@@ -88,7 +92,7 @@ namespace merge_and_shrink {
     if (verbosity >= Verbosity::VERBOSE) {
       cout << transition_system.tag();
     }
-    assert(!are_pareto_fronts_computed());
+    assert(!are_backward_pareto_fronts_computed());
     
     vector<size_t> backward_init;
     for (size_t state = 0; state < get_num_states(); ++state) {
@@ -97,11 +101,12 @@ namespace merge_and_shrink {
         }
     }
 
-    dijkstra_search.init(DijkstraSearch::BACKWARD, get_predecessors(), backward_init, get_num_states());
+    dijkstra_search.init(DijkstraSearch::BACKWARD, get_predecessors(), backward_init);
 
     dijkstra_search.compute(DijkstraSearch::BACKWARD, DijkstraSearch::PARETO);
+    dijkstra_search.release_transitions(DijkstraSearch::BACKWARD);
 
-    assert(are_pareto_fronts_computed());
+    assert(are_backward_pareto_fronts_computed());
   }
 
   vector<bool> Distances::compute_distances(Verbosity verbosity) {
@@ -141,11 +146,13 @@ namespace merge_and_shrink {
         }
     }
 
-    dijkstra_search.init(DijkstraSearch::FORWARD, get_successors(), forward_init, get_num_states());
-    dijkstra_search.init(DijkstraSearch::BACKWARD, get_predecessors(), backward_init, get_num_states());
+    dijkstra_search.init(DijkstraSearch::FORWARD, get_successors(), forward_init);
+    dijkstra_search.init(DijkstraSearch::BACKWARD, get_predecessors(), backward_init);
     
     dijkstra_search.compute(DijkstraSearch::FORWARD, DijkstraSearch::ORDINARY);
     dijkstra_search.compute(DijkstraSearch::BACKWARD, DijkstraSearch::ORDINARY);
+    dijkstra_search.release_transitions(DijkstraSearch::FORWARD);
+    dijkstra_search.release_transitions(DijkstraSearch::BACKWARD);
 
     max_f = 0;
     max_g = 0;
@@ -188,8 +195,10 @@ namespace merge_and_shrink {
     assert(are_distances_computed());
 
     int new_num_states = state_equivalence_relation.size();
-    vector<ParetoFront> new_init_distances(new_num_states);
-    vector<ParetoFront> new_goal_distances(new_num_states);
+    ParetoFrontTable new_init_distances;
+    ParetoFrontTable new_goal_distances;
+    new_init_distances.resize(new_num_states);
+    new_goal_distances.resize(new_num_states);
 
     bool must_recompute = false;
     for (int new_state = 0; new_state < new_num_states; ++new_state) {
@@ -198,8 +207,8 @@ namespace merge_and_shrink {
       assert(!state_equivalence_class.empty());
       
       size_t ref_state = *state_equivalence_class.begin();
-      ParetoFront new_init_front = dijkstra_search.get_pareto_front(DijkstraSearch::FORWARD, ref_state);
-      ParetoFront new_goal_front = dijkstra_search.get_pareto_front(DijkstraSearch::BACKWARD, ref_state);
+      ParetoFrontView new_init_front = dijkstra_search.get_pareto_front(DijkstraSearch::FORWARD, ref_state);
+      ParetoFrontView new_goal_front = dijkstra_search.get_pareto_front(DijkstraSearch::BACKWARD, ref_state);
       
       for(size_t old_state : state_equivalence_class) {
 	if(dijkstra_search.get_value(DijkstraSearch::FORWARD, old_state) != new_init_front.get_min_h_pair().h ||
@@ -212,8 +221,8 @@ namespace merge_and_shrink {
       if (must_recompute)
 	break;
 
-      new_init_distances[new_state] = new_init_front;
-      new_goal_distances[new_state] = new_goal_front;
+      new_init_distances.set_front(new_state, new_init_front);
+      new_goal_distances.set_front(new_state, new_goal_front);
     }
 
     if (must_recompute) {
@@ -224,8 +233,8 @@ namespace merge_and_shrink {
       clear_distances();
       compute_distances(verbosity);
     } else {
-      dijkstra_search.set_values(DijkstraSearch::FORWARD, new_init_distances);
-      dijkstra_search.set_values(DijkstraSearch::BACKWARD, new_goal_distances);
+      dijkstra_search.set_values(DijkstraSearch::FORWARD, move(new_init_distances));
+      dijkstra_search.set_values(DijkstraSearch::BACKWARD, move(new_goal_distances));
     }
   }
 
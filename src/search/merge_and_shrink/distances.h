@@ -61,8 +61,9 @@ class TransitionSystem;
     
     size_t get_num_states() const;
 
-    function<vector< DijkstraSearch::Successor>(const size_t state) >  get_successors() const;
-    function<vector< DijkstraSearch::Successor>(const size_t state) >  get_predecessors() const;
+    DijkstraSearch::TransitionGraph build_transition_graph(bool backward) const;
+    DijkstraSearch::TransitionGraph get_successors() const;
+    DijkstraSearch::TransitionGraph get_predecessors() const;
     
 public:
     explicit Distances(const TransitionSystem &transition_system, const int bound = INF);
@@ -104,7 +105,9 @@ public:
 
     void compute_backward_pareto_fronts(Verbosity verbosity);
     
-    ParetoFront& get_backward_pareto_front(const size_t state);
+    ParetoFrontView get_backward_pareto_front(const size_t state) const;
+    // Moves the backward fronts out, which also clears the distances.
+    ParetoFrontTable release_backward_pareto_fronts();
     
     void dump() const;
     void statistics() const;
@@ -318,8 +318,10 @@ void MergeAndShrinkHeuristic::build(const utils::Timer &timer) {
     return cost;
   }
   
-  int MergeAndShrinkHeuristic::compute_heuristic(const GlobalState &global_state, int g, int bound, int u) {
+  int MergeAndShrinkHeuristic::compute_heuristic(const GlobalState &global_state, int g, int bound, int u,
+						  DepthHistogram *depth_histogram) {
     (void)u;
+    (void)depth_histogram;
     State state = convert_global_state(global_state);
     int h = mas_representation->get_value(state, g, bound);
     if (h == PRUNED_STATE)
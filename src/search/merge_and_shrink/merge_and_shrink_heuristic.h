@@ -50,7 +50,11 @@ class MergeAndShrinkHeuristic : public Heuristic {
     void warn_on_unusual_options() const;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
-    virtual int compute_heuristic(const GlobalState &global_state, int g, int bound, int u=-1) override;
+    virtual int compute_heuristic(const GlobalState &global_state, int g, int bound, int u,
+				  DepthHistogram *depth_histogram) override;
+    virtual bool is_reentrant() const override {
+        return true;
+    }
 public:
     explicit MergeAndShrinkHeuristic(const options::Options &opts);
     virtual ~MergeAndShrinkHeuristic() override = default;
@@ -1,11 +1,12 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 
+#include "../dijkstra_search/pareto_front_table.h"
+
 #include <memory>
 #include <vector>
 
 class State;
-class ParetoFront;
 
 namespace merge_and_shrink {
 class Distances;
@@ -14,20 +15,32 @@ class MergeAndShrinkRepresentation {
 protected:
     int domain_size;
 
+    /*
+      The Pareto fronts of the abstract states, if set_distances got
+      them. They are only stored once, at the root, and indexed by the
+      abstract states that the lookup tables keep in this case.
+    */
+    ParetoFrontTable pareto_fronts;
+
+    // Return the entry of the lookup table for the state.
+    virtual int lookup(const State &state) const = 0;
+    virtual void apply_distances_to_lookup_table(
+        const Distances &distances) = 0;
+
 public:
     explicit MergeAndShrinkRepresentation(int domain_size);
     virtual ~MergeAndShrinkRepresentation() = 0;
 
     // Store distances instead of abstract state numbers.
-    virtual void set_distances(Distances &distances) = 0;
+    void set_distances(Distances &distances);
     
     int get_domain_size() const;
 
     // Return the abstract state or the goal distance, depending on whether
     // set_distances has been used or not.
-    virtual int get_value(const State &state) const = 0;
+    int get_value(const State &state) const;
 
-    virtual int get_value(const State &state, const int g, const int bound) const = 0;
+    int get_value(const State &state, const int g, const int bound) const;
     
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) = 0;
@@ -39,18 +52,18 @@ class MergeAndShrinkRepresentationLeaf : public MergeAndShrinkRepresentation {
     const int var_id;
 
     std::vector<int> lookup_table;
-    std::vector< ParetoFront > pareto_fronts;
-    
+
+protected:
+    virtual int lookup(const State &state) const override;
+    virtual void apply_distances_to_lookup_table(
+        const Distances &distances) override;
+
 public:
     MergeAndShrinkRepresentationLeaf(int var_id, int domain_size);
     virtual ~MergeAndShrinkRepresentationLeaf() = default;
 
-    virtual void set_distances(Distances &distances) override;
-    
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) override;
-    virtual int get_value(const State &state) const override;
-    virtual int get_value(const State &state, const int g, const int bound) const override;
 
     virtual void dump() const override;
 };
@@ -59,22 +72,24 @@ public:
 class MergeAndShrinkRepresentationMerge : public MergeAndShrinkRepresentation {
     std::unique_ptr<MergeAndShrinkRepresentation> left_child;
     std::unique_ptr<MergeAndShrinkRepresentation> right_child;
-    std::vector<std::vector<int>> lookup_table;
+    // Row-major: the entry for (state1, state2) is at
+    // state1 * num_right_states + state2.
+    const int num_right_states;
+    std::vector<int> lookup_table;
+
+protected:
+    virtual int lookup(const State &state) const override;
+    virtual void apply_distances_to_lookup_table(
+        const Distances &distances) override;
 
-    std::vector< std::vector< ParetoFront > > pareto_fronts;
-    
 public:
     MergeAndShrinkRepresentationMerge(
         std::unique_ptr<MergeAndShrinkRepresentation> left_child,
         std::unique_ptr<MergeAndShrinkRepresentation> right_child);
     virtual ~MergeAndShrinkRepresentationMerge() = default;
 
-    virtual void set_distances(Distances &distances) override;
-    
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) override;
-    virtual int get_value(const State &state) const override;
-    virtual int get_value(const State &state, const int g, const int bound) const override;
     
     virtual void dump() const override;
 };
@@ -11,6 +11,8 @@
 
 #include <cassert>
 #include <deque>
+#include <limits>
+#include <map>
 #include <set>
 #include <unordered_map>
 #include <utility>
@@ -19,6 +21,37 @@
 using namespace std;
 
 
+static void get_involved_heuristics(
+    const vector<ScalarEvaluator *> &evaluators, set<Heuristic *> &hset) {
+    for (ScalarEvaluator *evaluator : evaluators)
+        evaluator->get_involved_heuristics(hset);
+}
+
+static bool is_reliable_dead_end(
+    const vector<ScalarEvaluator *> &evaluators,
+    EvaluationContext &eval_context) {
+    for (ScalarEvaluator *evaluator : evaluators)
+        if (eval_context.is_heuristic_infinite(evaluator) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+static bool is_dead_end(
+    const vector<ScalarEvaluator *> &evaluators,
+    EvaluationContext &eval_context) {
+    // TODO: Document this behaviour.
+    // If one safe heuristic detects a dead end, return true.
+    if (is_reliable_dead_end(evaluators, eval_context))
+        return true;
+    // Otherwise, return true if all heuristics agree this is a dead-end.
+    for (ScalarEvaluator *evaluator : evaluators)
+        if (!eval_context.is_heuristic_infinite(evaluator))
+            return false;
+    return true;
+}
+
+
 template<class Entry>
 class ParetoOpenList : public OpenList<Entry> {
     typedef deque<Entry> Bucket;
@@ -160,7 +193,7 @@ Entry ParetoOpenList<Entry>::remove_min(vector<int> *key) {
          it != nondominated.end(); ++it) {
         int numerator;
         if (state_uniform_selection)
-            numerator = it->size();
+            numerator = buckets.find(*it)->second.size();
         else
             numerator = 1;
         seen += numerator;
@@ -193,32 +226,205 @@ void ParetoOpenList<Entry>::clear() {
 
 template<class Entry>
 void ParetoOpenList<Entry>::get_involved_heuristics(set<Heuristic *> &hset) {
-    for (ScalarEvaluator *evaluator : evaluators)
-        evaluator->get_involved_heuristics(hset);
+    ::get_involved_heuristics(evaluators, hset);
 }
 
 template<class Entry>
 bool ParetoOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
-    // TODO: Document this behaviour.
-    // If one safe heuristic detects a dead end, return true.
-    if (is_reliable_dead_end(eval_context))
-        return true;
-    // Otherwise, return true if all heuristics agree this is a dead-end.
-    for (ScalarEvaluator *evaluator : evaluators)
-        if (!eval_context.is_heuristic_infinite(evaluator))
-            return false;
-    return true;
+    return ::is_dead_end(evaluators, eval_context);
 }
 
 template<class Entry>
 bool ParetoOpenList<Entry>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
-    for (ScalarEvaluator *evaluator : evaluators)
-        if (eval_context.is_heuristic_infinite(evaluator) &&
-            evaluator->dead_ends_are_reliable())
-            return true;
-    return false;
+    return ::is_reliable_dead_end(evaluators, eval_context);
+}
+
+
+/*
+  Pareto open list for exactly two evaluators. The nondominated keys
+  form a staircase: ordered by increasing first value, their second
+  values strictly decrease. So whether a new key is dominated and
+  which keys it dominates can be found by binary search. When the
+  bucket of a nondominated key runs empty, only keys in the strip
+  between its neighbours on the staircase can become nondominated,
+  and the ordered bucket map yields them with one lookup per first
+  value in the strip.
+
+  Selection is the same as in ParetoOpenList, which also visits the
+  nondominated keys in lexicographic order.
+*/
+template<class Entry>
+class TwoEvaluatorParetoOpenList : public OpenList<Entry> {
+    typedef deque<Entry> Bucket;
+    typedef pair<int, int> KeyType;
+    typedef map<KeyType, Bucket> BucketMap;
+    // Maps the first value of each nondominated key to its second value.
+    typedef map<int, int> Staircase;
+
+    BucketMap buckets;
+    Staircase nondominated;
+    bool state_uniform_selection;
+    vector<ScalarEvaluator *> evaluators;
+
+    bool is_nondominated(const KeyType &key) const;
+    void insert_nondominated(const KeyType &key);
+    void remove_key(KeyType key);
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit TwoEvaluatorParetoOpenList(const Options &opts);
+    virtual ~TwoEvaluatorParetoOpenList() override = default;
+
+    virtual Entry remove_min(vector<int> *key = nullptr) override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_involved_heuristics(set<Heuristic *> &hset) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+template<class Entry>
+TwoEvaluatorParetoOpenList<Entry>::TwoEvaluatorParetoOpenList(
+    const Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      state_uniform_selection(opts.get<bool>("state_uniform_selection")),
+      evaluators(opts.get_list<ScalarEvaluator *>("evals")) {
+    assert(evaluators.size() == 2);
+}
+
+template<class Entry>
+bool TwoEvaluatorParetoOpenList<Entry>::is_nondominated(
+    const KeyType &key) const {
+    // Only the last key on the staircase with a first value not above
+    // key.first can dominate key.
+    auto it = nondominated.upper_bound(key.first);
+    if (it == nondominated.begin())
+        return true;
+    --it;
+    return it->second > key.second;
+}
+
+template<class Entry>
+void TwoEvaluatorParetoOpenList<Entry>::insert_nondominated(
+    const KeyType &key) {
+    // The keys dominated by key directly follow it on the staircase.
+    auto it = nondominated.lower_bound(key.first);
+    while (it != nondominated.end() && it->second >= key.second)
+        it = nondominated.erase(it);
+    nondominated.emplace_hint(it, key.first, key.second);
+}
+
+template<class Entry>
+void TwoEvaluatorParetoOpenList<Entry>::remove_key(KeyType key) {
+    auto next = nondominated.find(key.first);
+    assert(next != nondominated.end() && next->second == key.second);
+    next = nondominated.erase(next);
+    buckets.erase(key);
+
+    /*
+      A remaining key becomes nondominated iff its first value lies in
+      [key.first, next->first) and its second value is below that of
+      the previous key on the staircase and below those of the keys
+      found before it in the strip. For each first value, only the key
+      with the smallest second value can qualify.
+    */
+    bool has_upper_bound = next != nondominated.begin();
+    int upper_bound = has_upper_bound ? prev(next)->second : 0;
+    auto it = buckets.lower_bound(
+        KeyType(key.first, numeric_limits<int>::min()));
+    while (it != buckets.end() &&
+           (next == nondominated.end() || it->first.first < next->first)) {
+        const KeyType &candidate = it->first;
+        if (!has_upper_bound || candidate.second < upper_bound) {
+            nondominated.emplace_hint(next, candidate.first, candidate.second);
+            has_upper_bound = true;
+            upper_bound = candidate.second;
+        }
+        it = buckets.upper_bound(
+            KeyType(candidate.first, numeric_limits<int>::max()));
+    }
+}
+
+template<class Entry>
+void TwoEvaluatorParetoOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    KeyType key(
+        eval_context.get_heuristic_value_or_infinity(evaluators[0]),
+        eval_context.get_heuristic_value_or_infinity(evaluators[1]));
+
+    Bucket &bucket = buckets[key];
+    bool newkey = bucket.empty();
+    bucket.push_back(entry);
+
+    if (newkey && is_nondominated(key))
+        insert_nondominated(key);
+}
+
+template<class Entry>
+Entry TwoEvaluatorParetoOpenList<Entry>::remove_min(vector<int> *key) {
+    typename Staircase::const_iterator selected = nondominated.begin();
+    int seen = 0;
+    for (typename Staircase::const_iterator it = nondominated.begin();
+         it != nondominated.end(); ++it) {
+        int numerator;
+        if (state_uniform_selection)
+            numerator = buckets.find(KeyType(it->first, it->second))
+                ->second.size();
+        else
+            numerator = 1;
+        seen += numerator;
+        if ((*g_rng())(seen) < numerator)
+            selected = it;
+    }
+    KeyType selected_key(selected->first, selected->second);
+    if (key) {
+        assert(key->empty());
+        key->push_back(selected_key.first);
+        key->push_back(selected_key.second);
+    }
+
+    Bucket &bucket = buckets[selected_key];
+    Entry result = bucket.front();
+    bucket.pop_front();
+    if (bucket.empty())
+        remove_key(selected_key);
+    return result;
+}
+
+template<class Entry>
+bool TwoEvaluatorParetoOpenList<Entry>::empty() const {
+    return nondominated.empty();
+}
+
+template<class Entry>
+void TwoEvaluatorParetoOpenList<Entry>::clear() {
+    buckets.clear();
+    nondominated.clear();
+}
+
+template<class Entry>
+void TwoEvaluatorParetoOpenList<Entry>::get_involved_heuristics(
+    set<Heuristic *> &hset) {
+    ::get_involved_heuristics(evaluators, hset);
+}
+
+template<class Entry>
+bool TwoEvaluatorParetoOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    return ::is_dead_end(evaluators, eval_context);
+}
+
+template<class Entry>
+bool TwoEvaluatorParetoOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    return ::is_reliable_dead_end(evaluators, eval_context);
 }
 
 ParetoOpenListFactory::ParetoOpenListFactory(
@@ -226,21 +432,32 @@ ParetoOpenListFactory::ParetoOpenListFactory(
     : options(options) {
 }
 
+template<class Entry>
+static unique_ptr<OpenList<Entry>> create_pareto_open_list(
+    const Options &options) {
+    if (options.get_list<ScalarEvaluator *>("evals").size() == 2)
+        return utils::make_unique_ptr<TwoEvaluatorParetoOpenList<Entry>>(
+            options);
+    return utils::make_unique_ptr<ParetoOpenList<Entry>>(options);
+}
+
 unique_ptr<StateOpenList>
 ParetoOpenListFactory::create_state_open_list() {
-    return utils::make_unique_ptr<ParetoOpenList<StateOpenListEntry>>(options);
+    return create_pareto_open_list<StateOpenListEntry>(options);
 }
 
 unique_ptr<EdgeOpenList>
 ParetoOpenListFactory::create_edge_open_list() {
-    return utils::make_unique_ptr<ParetoOpenList<EdgeOpenListEntry>>(options);
+    return create_pareto_open_list<EdgeOpenListEntry>(options);
 }
 
 static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Pareto open list",
         "Selects one of the Pareto-optimal (regarding the sub-evaluators) "
-        "entries for removal.");
+        "entries for removal. With exactly two evaluators, the Pareto-optimal "
+        "keys are kept as a sorted staircase, so inserting and removing keys "
+        "takes logarithmic instead of quadratic time.");
 
     parser.add_list_option<ScalarEvaluator *>("evals", "scalar evaluators");
     parser.add_option<bool>(
@@ -0,0 +1,203 @@
+#include "potential_open_list.h"
+
+#include "open_list.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+
+template<class Entry>
+class PotentialOpenList : public OpenList<Entry> {
+    /*
+      The inverse potential (C + 1 - g) / (C + 1 - g - h) of an entry
+      as a fraction with a positive denominator. Entries with g + h > C
+      have no positive potential and are treated as dead ends.
+    */
+    struct HeapEntry {
+        int64_t numerator;
+        int64_t denominator;
+        uint64_t insertion_order;
+        int g;
+        int h;
+        Entry entry;
+
+        HeapEntry(int g, int h, int bound, uint64_t insertion_order,
+                  const Entry &entry)
+            : numerator(static_cast<int64_t>(bound) + 1 - g),
+              denominator(numerator - h),
+              insertion_order(insertion_order),
+              g(g),
+              h(h),
+              entry(entry) {
+            assert(denominator > 0);
+        }
+    };
+
+    /*
+      Orders the heap such that the entry with the highest potential is
+      at the front. Ties are broken in favour of lower h, then of older
+      entries.
+    */
+    struct Later {
+        bool operator()(const HeapEntry &lhs, const HeapEntry &rhs) const {
+            const int64_t lhs_value = lhs.numerator * rhs.denominator;
+            const int64_t rhs_value = rhs.numerator * lhs.denominator;
+            if (lhs_value != rhs_value)
+                return lhs_value > rhs_value;
+            if (lhs.h != rhs.h)
+                return lhs.h > rhs.h;
+            return lhs.insertion_order > rhs.insertion_order;
+        }
+    };
+
+    vector<HeapEntry> heap;
+    uint64_t num_insertions;
+
+    ScalarEvaluator *g_evaluator;
+    ScalarEvaluator *h_evaluator;
+    ScalarEvaluator *bound_evaluator;
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit PotentialOpenList(const Options &opts);
+    virtual ~PotentialOpenList() override = default;
+
+    virtual Entry remove_min(vector<int> *key = nullptr) override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_involved_heuristics(set<Heuristic *> &hset) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+PotentialOpenList<Entry>::PotentialOpenList(const Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      num_insertions(0) {
+    vector<ScalarEvaluator *> evals =
+        opts.get_list<ScalarEvaluator *>("evals");
+    assert(evals.size() == 3);
+    g_evaluator = evals[0];
+    h_evaluator = evals[1];
+    bound_evaluator = evals[2];
+}
+
+template<class Entry>
+void PotentialOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    heap.emplace_back(
+        eval_context.get_heuristic_value(g_evaluator),
+        eval_context.get_heuristic_value(h_evaluator),
+        eval_context.get_heuristic_value(bound_evaluator),
+        num_insertions++, entry);
+    push_heap(heap.begin(), heap.end(), Later());
+}
+
+template<class Entry>
+Entry PotentialOpenList<Entry>::remove_min(vector<int> *key) {
+    assert(!heap.empty());
+    pop_heap(heap.begin(), heap.end(), Later());
+    const HeapEntry &min_entry = heap.back();
+    if (key) {
+        assert(key->empty());
+        key->push_back(min_entry.g);
+        key->push_back(min_entry.h);
+    }
+    Entry result = min_entry.entry;
+    heap.pop_back();
+    return result;
+}
+
+template<class Entry>
+bool PotentialOpenList<Entry>::empty() const {
+    return heap.empty();
+}
+
+template<class Entry>
+void PotentialOpenList<Entry>::clear() {
+    heap.clear();
+}
+
+template<class Entry>
+void PotentialOpenList<Entry>::get_involved_heuristics(
+    set<Heuristic *> &hset) {
+    g_evaluator->get_involved_heuristics(hset);
+    h_evaluator->get_involved_heuristics(hset);
+    bound_evaluator->get_involved_heuristics(hset);
+}
+
+template<class Entry>
+bool PotentialOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    if (eval_context.is_heuristic_infinite(g_evaluator) ||
+        eval_context.is_heuristic_infinite(h_evaluator))
+        return true;
+    int64_t g = eval_context.get_heuristic_value(g_evaluator);
+    int64_t h = eval_context.get_heuristic_value(h_evaluator);
+    return g + h > eval_context.get_heuristic_value_or_infinity(
+        bound_evaluator);
+}
+
+template<class Entry>
+bool PotentialOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    return (eval_context.is_heuristic_infinite(g_evaluator) &&
+            g_evaluator->dead_ends_are_reliable()) ||
+           (eval_context.is_heuristic_infinite(h_evaluator) &&
+            h_evaluator->dead_ends_are_reliable());
+}
+
+PotentialOpenListFactory::PotentialOpenListFactory(
+    const Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+PotentialOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<PotentialOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+PotentialOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<PotentialOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Potential open list",
+        "Open list for potential search (PTS). Selects the entry with the "
+        "highest potential 1 - h / (C + 1 - g), breaking ties in favour of "
+        "lower h and then of older entries. Potentials are compared exactly, "
+        "so no tie-breaking open list is needed to tell them apart, unlike "
+        "with the rounded pts evaluator. States with g + h > C are pruned.");
+    parser.add_list_option<ScalarEvaluator *>(
+        "evals", "three scalar evaluators [g(), h, C]");
+    parser.add_option<bool>(
+        "pref_only",
+        "insert only nodes generated by preferred operators", "false");
+
+    Options opts = parser.parse();
+    if (opts.get_list<ScalarEvaluator *>("evals").size() != 3)
+        parser.error("potential open list needs the evaluators [g(), h, C]");
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<PotentialOpenListFactory>(opts);
+}
+
+static PluginShared<OpenListFactory> _plugin("potential", _parse);
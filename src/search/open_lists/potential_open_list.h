@@ -0,0 +1,31 @@
+#ifndef OPEN_LISTS_POTENTIAL_OPEN_LIST_H
+#define OPEN_LISTS_POTENTIAL_OPEN_LIST_H
+
+#include "open_list_factory.h"
+
+#include "../option_parser_util.h"
+
+
+/*
+  Open list for potential search (PTS) that orders the entries by the
+  exact potential 1 - h / (C + 1 - g), highest first, breaking ties by
+  lower h and then FIFO. The potential is compared as a fraction of
+  integers, so, unlike the pts evaluator, distinct potentials are never
+  rounded to the same key. States with g + h > C are dead ends.
+
+  Implemented as a binary heap. Entries are never updated in place:
+  the search skips stale ones when it removes them.
+*/
+
+
+class PotentialOpenListFactory : public OpenListFactory {
+    Options options;
+public:
+    explicit PotentialOpenListFactory(const Options &options);
+    virtual ~PotentialOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+
+#endif
@@ -3,6 +3,9 @@
 #include "dominance_pruning.h"
 #include "pattern_database.h"
 
+#include "../depth_histogram.h"
+
+#include "../utils/system.h"
 
 #include <cassert>
 #include <iostream>
@@ -12,21 +15,23 @@ using namespace std;
 
 namespace pdbs {
 
-  vector<int>  CanonicalPDBs::expanded = vector<int>();
-  
   CanonicalPDBs::CanonicalPDBs(
 			       const shared_ptr<PDBCollection> &pattern_databases,
 			       const shared_ptr<MaxAdditivePDBSubsets> &max_additive_subsets_,
 			       bool dominance_pruning,
 			       bool pareto,
 			       std::string objective_name,
-			       std::string aggregate_name)
+			       std::string aggregate_name,
+			       bool objective_lookup)
     : pattern_databases(pattern_databases),
       max_additive_subsets(max_additive_subsets_),
       pareto(pareto),
       objective_name(objective_name),
       aggregate_name(aggregate_name),
-      compute_b(false){
+      compute_b(false),
+      objective_lookup(objective_lookup),
+      evaluator(nullptr),
+      bounded_evaluator(nullptr){
   
     assert(max_additive_subsets);
     if (dominance_pruning) {
@@ -34,75 +39,64 @@ namespace pdbs {
 						     *pattern_databases, *max_additive_subsets);
     }
 
-    if(objective_name.compare("d") == 0) {
-      objective = [](const int h, const int d, const int g, const int bound, const int b) {
-	return (double) d;
-	(void)h;
-	(void)g;
-	(void)bound;
-	(void)b;
-      };
-    } else if (objective_name.compare("ework") == 0) {
-      objective = [](const int h, const int d, const int g, const int bound, const int b) {
-	double potential =
-	(h > bound - g) ? 0 :
-	(h == 0) ? 1 :
-	1 - (h / (double) (bound + 1 - g));
-	
-	return pow(d, b) / potential;
-      };
-      compute_b = true;
-      
-    } else if (objective_name.compare("h") == 0) {
-      objective = [](const int h, const int d, const int g, const int bound, const int b) {
-	return (double) h;
-	(void)d;
-	(void)g;
-	(void)bound;
-	(void)b;
-      };
-    } else if  (objective_name.compare("pts") == 0) {
-      objective = [](const int h, const int d, const int g, const int bound, const int b) {
-	double potential =
-	(h > bound - g) ? 0 :
-	(h == 0) ? 1 :
-	1 - (h / (double) (bound + 1 - g));
-	
-	return 1 / potential;
-	(void)d;
-	(void)b;
-      };
+    if(objective_name == "d") {
+      select_evaluators<objectives::Distance>(aggregate_name);
+    } else if(objective_name == "h") {
+      select_evaluators<objectives::HeuristicValue>(aggregate_name);
+    } else if(objective_name == "pts") {
+      select_evaluators<objectives::Potential>(aggregate_name);
+    } else if(objective_name == "ework") {
+      select_evaluators<objectives::ExpectedWork>(aggregate_name);
     } else {
-      cout << "ERROR: " << objective_name << " is not a known objective function.";
-      assert(false);
+      cerr << "ERROR: " << objective_name
+	   << " is not a known objective function." << endl;
+      utils::exit_with(utils::ExitCode::INPUT_ERROR);
     }
+  }
 
-    if(aggregate_name.compare("sum") == 0) {
-      aggregate = [](const vector<double>& values) {
-	double total = 0;
-	for(auto v : values)
-	  total += v;
-	return total;
-      };
-    } else if (aggregate_name.compare("max") == 0) {
-      aggregate = [](const vector<double>& values) {
-	return *max_element(values.begin(), values.end());
-      };
-    } else if (aggregate_name.compare("min") == 0) {
-      aggregate = [](const vector<double>& values) {
-	return *min_element(values.begin(), values.end());
-      };
+  template<class Objective>
+  void CanonicalPDBs::select_evaluators(const string &aggregate_name) {
+    compute_b = Objective::USES_B;
+    if(aggregate_name == "sum") {
+      evaluator = &CanonicalPDBs::compute_value<aggregates::Sum>;
+      bounded_evaluator =
+	&CanonicalPDBs::compute_bounded_value<Objective, aggregates::Sum>;
+    } else if(aggregate_name == "max") {
+      evaluator = &CanonicalPDBs::compute_value<aggregates::Max>;
+      bounded_evaluator =
+	&CanonicalPDBs::compute_bounded_value<Objective, aggregates::Max>;
+    } else if(aggregate_name == "min") {
+      evaluator = &CanonicalPDBs::compute_value<aggregates::Min>;
+      bounded_evaluator =
+	&CanonicalPDBs::compute_bounded_value<Objective, aggregates::Min>;
     } else {
-      cout << "ERROR: " << aggregate_name << " is not a known aggregator function.";
-      assert(false);
+      cerr << "ERROR: " << aggregate_name
+	   << " is not a known aggregator function." << endl;
+      utils::exit_with(utils::ExitCode::INPUT_ERROR);
     }
   }
 
+  // Rounds the aggregated value and avoids integer overflows.
+  // INF is reserved for pruning nodes, so all values geq to INF
+  // are returned as INF - 1.
+  static int round_aggregate(const double value) {
+    const double rounded = round(value);
+    return (rounded < (double) DijkstraSearch::INF) ?
+      (int) rounded :
+      DijkstraSearch::INF - 1;
+  }
+
   int CanonicalPDBs::get_value(const State &state) const {
+    return (this->*evaluator)(state);
+  }
+
+  template<class Aggregate>
+  int CanonicalPDBs::compute_value(const State &state) const {
     // If we have an empty collection, then max_additive_subsets = { \emptyset }.
     assert(!max_additive_subsets->empty());
 
-    std::vector<double> values;
+    double value = 0;
+    bool first = true;
     for (const auto &subset : *max_additive_subsets) {
       int subset_h = 0;
       for (const shared_ptr<PatternDatabase> &pdb : subset) {
@@ -113,83 +107,97 @@ namespace pdbs {
 	  return numeric_limits<int>::max();
 	subset_h += h;
       }
-      values.push_back(subset_h);
+      value = first ? subset_h : Aggregate::combine(value, subset_h);
+      first = false;
     }
     
-    // Aggregate and avoid integer overflows.
-    // INF is reserved for out-of-bounds,
-    // so all values exceeding that amount are returned as
-    // INF - 1
-    double agg_value = round(aggregate(values));
-    return (agg_value < (double) DijkstraSearch::INF) ?
-      (int) agg_value :
-      DijkstraSearch::INF - 1;
+    // INF is reserved for out-of-bounds.
+    return round_aggregate(value);
+  }
+
+  void CanonicalPDBs::merge_subset_fronts(const PDBCollection &subset,
+					  const State &state,
+					  const int bound,
+					  ParetoFront &result) const {
+    // Perform an additive summation of the pareto fronts
+    result = ParetoFront(subset[0]->get_backward_pareto_front(state));
+    result.prune_with_bound(bound);
+    for(size_t i = 1; i < subset.size() && !result.empty(); i++)
+      result.merge_additive(subset[i]->get_backward_pareto_front(state),
+			    bound);
   }
 
   int CanonicalPDBs::get_value(const State &state,
 			       const int g, const int bound,
-			       const int u) const {
-    // If we have an empty collection, then max_additive_subsets = { \emptyset }.
-    assert(!max_additive_subsets->empty());
-
-    double b = 0;
+			       const int u,
+			       DepthHistogram *depth_histogram) const {
+    int b = 0;
     if(compute_b) {
-      // Compute depth stats for the expected work heuristic
-      while(expanded.size() <= (size_t) u)
-	expanded.push_back(0);
-      expanded[u]++;
+      // Depth stats for the expected work heuristic
+      b = 1;
+      if(depth_histogram) {
+	depth_histogram->add(u);
+	b = depth_histogram->get_branching_factor();
+      }
+    }
 
-      int max_u = expanded.size() - 2;
+    return (this->*bounded_evaluator)(state, g, bound, b);
+  }
 
-      int pre_jump = 0;
-      for(int i = 0; i <= max_u; i++)
-	pre_jump += expanded[i];
-    
-      b = (pre_jump < 10000) ? 1 : pow(pre_jump, 1.0 / max_u);
-    }
+  template<class Objective, class Aggregate>
+  int CanonicalPDBs::compute_bounded_value(const State &state,
+					   const int g, const int bound,
+					   const int b) const {
+    // If we have an empty collection, then max_additive_subsets = { \emptyset }.
+    assert(!max_additive_subsets->empty());
 
-    // Build the objective function with respect to the evaluation context
-    auto obj =  [this, g, bound, b] (const int h, const int d)
+    // The objective with respect to the evaluation context
+    auto obj = [g, bound, b] (const int h, const int d)
       {
-	return objective(h, d, g, bound, b);
+	return Objective::evaluate(h, d, g, bound, b);
       };
+    const BudgetLookup lookup =
+      objective_lookup ? Objective::LOOKUP : BudgetLookup::NONE;
     
-    // Compute the set of min objective values for each additive subset
-    std::vector<double> values;
-    for (const auto &subset : *max_additive_subsets) {
+    // Aggregate the min objective values of the additive subsets
+    double value = 0;
+    bool first = true;
+    ParetoFront merged;
+    for (const PDBCollection &subset : *max_additive_subsets) {
       if(subset.empty())
 	continue;
 
-      // Perform an additive summation of the pareto fronts
-      ParetoFront subset_pf = subset[0]->get_backward_pareto_front(state);
-      subset_pf.prune_with_bound(bound - g);
-      if(subset_pf.empty())
-	return DijkstraSearch::INF;
-      for(size_t i = 1; i < subset.size(); i++) {
-	subset_pf.merge_additive(subset[i]->get_backward_pareto_front(state),
-				 bound - g);
-	if(subset_pf.empty())
+      ParetoFront::ParetoPair min_pair(DijkstraSearch::INF, DijkstraSearch::INF);
+      if(subset.size() == 1 && lookup != BudgetLookup::NONE) {
+	const ParetoFrontView front = subset[0]->get_backward_pareto_front(state);
+	min_pair = (lookup == BudgetLookup::MIN_D) ?
+	  front.get_min_d_pair(bound - g) :
+	  front.get_min_h_pair(bound - g);
+	if(min_pair.h == DijkstraSearch::INF)
+	  return DijkstraSearch::INF;
+      } else {
+	merge_subset_fronts(subset, state, bound - g, merged);
+	if(merged.empty())
 	  return DijkstraSearch::INF;
+
+	// The merged front is already pruned to the budget.
+	min_pair =
+	  (lookup == BudgetLookup::MIN_D) ? merged.get_min_d_pair() :
+	  (lookup == BudgetLookup::MIN_H) ? merged.get_min_h_pair() :
+	  merged.get_min_pair(obj);
       }
-      
-      ParetoFront::ParetoPair min_pair = subset_pf.get_min_pair(obj);
       const double min_objective = obj(min_pair.h, min_pair.d);
 
       // Immediately prune on an infinite objective value
       if(min_objective == std::numeric_limits<double>::infinity())
 	return DijkstraSearch::INF;
 
-      values.push_back(min_objective);
+      value = first ? min_objective : Aggregate::combine(value, min_objective);
+      first = false;
     }
 
-    // Aggregate and avoid integer overflows.
     // INF is reserved for pruning nodes,
     // but all nodes that reach this point are valid.
-    // INF = int max, so all values geq to INF are returned as
-    // INF - 1
-    double agg_value = round(aggregate(values));
-    return (agg_value < (double) DijkstraSearch::INF) ?
-      (int) agg_value :
-      DijkstraSearch::INF - 1;
+    return round_aggregate(value);
   }
 }
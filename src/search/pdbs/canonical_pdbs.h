@@ -1,18 +1,18 @@
 #ifndef PDBS_CANONICAL_PDBS_H
 #define PDBS_CANONICAL_PDBS_H
 
+#include "pareto_objectives.h"
 #include "types.h"
 #include "../dijkstra_search/pareto_front.h"
 
 #include <memory>
 #include <algorithm>
 
+class DepthHistogram;
 class State;
 
 namespace pdbs {
 class CanonicalPDBs {
-  static std::vector<int> expanded;
- 
   std::shared_ptr<PDBCollection> pattern_databases;
   std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
 
@@ -20,10 +20,32 @@ class CanonicalPDBs {
   std::string objective_name;
   std::string aggregate_name;
 
-  std::function<double (std::vector<double>& values)> aggregate;
-  std::function<double (const int h, const int d, const int g, const int bound, const int b)> objective;
-  
   bool compute_b;
+
+  /*
+    If set, the pair minimising the objective within the budget is
+    looked up directly (see pareto_objectives.h) instead of scanning
+    the front; single-PDB subsets are then answered by a binary
+    search in the PDB's front without copying it.
+  */
+  bool objective_lookup;
+
+  // Instantiations of compute_value and compute_bounded_value for the
+  // aggregate and objective chosen at construction.
+  int (CanonicalPDBs::*evaluator)(const State &state) const;
+  int (CanonicalPDBs::*bounded_evaluator)(
+    const State &state, const int g, const int bound, const int b) const;
+
+  template<class Objective>
+  void select_evaluators(const std::string &aggregate_name);
+  template<class Aggregate>
+  int compute_value(const State &state) const;
+  template<class Objective, class Aggregate>
+  int compute_bounded_value(const State &state, const int g,
+			    const int bound, const int b) const;
+
+  void merge_subset_fronts(const PDBCollection &subset, const State &state,
+			   const int bound, ParetoFront &result) const;
   
 public:
     CanonicalPDBs(const std::shared_ptr<PDBCollection> &pattern_databases,
@@ -31,12 +53,21 @@ public:
                   bool dominance_pruning,
 		  bool pareto = false,
 		  std::string objective_name = "h",
-		  std::string aggregate = "max");
+		  std::string aggregate = "max",
+		  bool objective_lookup = true);
+    CanonicalPDBs(CanonicalPDBs &&other) = default;
     ~CanonicalPDBs() = default;
 
     int get_value(const State &state) const;
-    int get_value(const State &state, const int g,  const int bound, const int u) const;
+    // depth_histogram may be nullptr; ework then assumes b = 1.
+    int get_value(const State &state, const int g,  const int bound, const int u,
+		  DepthHistogram *depth_histogram) const;
 
+    // The bounded get_value only reads shared data unless it fills the
+    // depth statistics of ework.
+    bool is_reentrant() const {
+      return !compute_b;
+    }
 };
 }
 
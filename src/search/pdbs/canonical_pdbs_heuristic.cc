@@ -3,10 +3,14 @@
 #include "pattern_generator.h"
 
 #include "pattern_database.h"
+#include "pdb_builder.h"
+#include "pdb_cache.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../dijkstra_search/min_plus.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <iostream>
@@ -23,25 +27,53 @@ CanonicalPDBs get_canonical_pdbs_from_options(
     utils::Timer timer;
     PatternCollectionInformation pattern_collection_info =
         pattern_generator->generate(task);
+    bool pareto = opts.get<bool>("pareto");
+    int num_threads = opts.get<int>("threads", 1);
+    string cache_dir = opts.get<string>("cache_dir", "none");
+    TaskProxy task_proxy(*task);
+    shared_ptr<PDBCache> pdb_cache;
+    if (cache_dir != "none")
+        pdb_cache = make_shared<PDBCache>(task_proxy, cache_dir);
+    pattern_collection_info.set_pareto(pareto);
+    pattern_collection_info.set_num_threads(num_threads);
+    pattern_collection_info.set_pdb_cache(pdb_cache);
     shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs();
     shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets =
         pattern_collection_info.get_max_additive_subsets();
     cout << "PDB collection construction time: " << timer << endl;
 
     bool dominance_pruning = opts.get<bool>("dominance_pruning");
-    bool pareto = opts.get<bool>("pareto");
     string objective = opts.get<string>("objective");
 
     string aggregate = opts.get<string>("aggregate");
+    bool objective_lookup = opts.get<bool>("objective_lookup", true);
+    bool forward_pruning = opts.get<bool>("forward_pruning", false);
 
     if(pareto) { 
-      TaskProxy task_proxy(*task);
-      for(auto pdb : *pdbs) {
-	pdb->compute_backward_pareto_fronts(task_proxy);
+      cout << "Additive merge kernel: "
+	   << min_plus::get_implementation_name() << endl;
+      vector<PDBJob> jobs;
+      for(const shared_ptr<PatternDatabase> &pdb : *pdbs) {
+	// PDBs built in pareto mode already have their fronts.
+	if(pdb->are_backward_pareto_fronts_computed() && !forward_pruning)
+	  continue;
+	jobs.emplace_back(pdb->get_pattern(), pdb->get_size(),
+			  [&task_proxy, pdb, forward_pruning, &pdb_cache]() {
+			    pdb->compute_backward_pareto_fronts(
+			      task_proxy, vector<int>(), forward_pruning,
+			      pdb_cache.get());
+			  });
+      }
+      if(!jobs.empty()) {
+	utils::ThreadPool pool(num_threads);
+	run_pdb_jobs(pool, jobs, true);
       }
     }
+    if (pdb_cache)
+      pdb_cache->print_statistics();
     
-    return CanonicalPDBs(pdbs, max_additive_subsets, dominance_pruning, pareto, objective, aggregate);
+    return CanonicalPDBs(pdbs, max_additive_subsets, dominance_pruning, pareto,
+                         objective, aggregate, objective_lookup);
 }
 
 CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(const Options &opts)
@@ -63,13 +95,15 @@ int CanonicalPDBsHeuristic::compute_heuristic(const State &state) const {
     }
 }
 
-  int CanonicalPDBsHeuristic::compute_heuristic(const GlobalState &global_state, const int g, const int bound, const int u) {
+  int CanonicalPDBsHeuristic::compute_heuristic(const GlobalState &global_state, const int g, const int bound, const int u,
+						 DepthHistogram *depth_histogram) {
     State state = convert_global_state(global_state);
-    return compute_heuristic(state, g, bound, u);
+    return compute_heuristic(state, g, bound, u, depth_histogram);
 }
 
-  int CanonicalPDBsHeuristic::compute_heuristic(const State &state, const int g, const int bound, const int u) const {
-    int h = canonical_pdbs.get_value(state, g, bound, u);
+  int CanonicalPDBsHeuristic::compute_heuristic(const State &state, const int g, const int bound, const int u,
+						 DepthHistogram *depth_histogram) const {
+    int h = canonical_pdbs.get_value(state, g, bound, u, depth_histogram);
     if (h == numeric_limits<int>::max()) {
         return DEAD_END;
     } else {
@@ -116,6 +150,33 @@ static Heuristic *_parse(OptionParser &parser) {
         "aggregate",
         "Aggregate function for pareto front iteration",
         "max");
+     parser.add_option<bool>(
+        "objective_lookup",
+        "For the d, h and pts objectives, look up the best pair within the "
+        "remaining budget by binary search instead of scanning pareto fronts "
+        "with the objective function.",
+        "true");
+     parser.add_option<bool>(
+        "forward_pruning",
+        "Before computing the pareto fronts of a PDB built with a cost bound, "
+        "compute the abstract distances from the initial state and drop all "
+        "pairs whose abstract plan cost exceeds the bound.",
+        "false");
+     parser.add_option<int>(
+        "threads",
+        "Number of threads for building the PDBs and their pareto fronts, "
+        "if the pattern generator leaves this to the heuristic. The "
+        "number of PDBs built at the same time is also limited by the "
+        "memory limit.",
+        "1",
+        Bounds("1", "infinity"));
+     parser.add_option<string>(
+        "cache_dir",
+        "Existing directory in which PDBs and their pareto fronts are "
+        "stored on disk, keyed by the task, pattern, operator costs and "
+        "cost bound. Later runs map them into memory instead of building "
+        "them again. none disables the cache.",
+        "none");
 
     Heuristic::add_options_to_parser(parser);
 
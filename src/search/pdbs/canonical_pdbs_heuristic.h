@@ -18,8 +18,14 @@ protected:
        for a State object. */
     int compute_heuristic(const State &state) const;
 
-    virtual int compute_heuristic(const GlobalState &state, const int g, const int bound, const int u) override;
-    int compute_heuristic(const State &state, const int g, const int bound, const int u) const;
+    virtual int compute_heuristic(const GlobalState &state, const int g, const int bound, const int u,
+				  DepthHistogram *depth_histogram) override;
+    int compute_heuristic(const State &state, const int g, const int bound, const int u,
+			  DepthHistogram *depth_histogram) const;
+
+    virtual bool is_reentrant() const override {
+        return canonical_pdbs.is_reentrant();
+    }
 
 public:
     explicit CanonicalPDBsHeuristic(const options::Options &opts);
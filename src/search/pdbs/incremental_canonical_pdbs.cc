@@ -12,7 +12,8 @@ using namespace std;
 
 namespace pdbs {
 IncrementalCanonicalPDBs::IncrementalCanonicalPDBs(
-						   const TaskProxy &task_proxy, const PatternCollection &intitial_patterns, const int bound)
+						   const TaskProxy &task_proxy, const PatternCollection &intitial_patterns, const int bound,
+						   bool pareto)
     : task_proxy(task_proxy),
       patterns(make_shared<PatternCollection>(intitial_patterns.begin(),
                                               intitial_patterns.end())),
@@ -22,7 +23,7 @@ IncrementalCanonicalPDBs::IncrementalCanonicalPDBs(
     utils::Timer timer;
     pattern_databases->reserve(patterns->size());
     for (const Pattern &pattern : *patterns) {
-      pattern_databases->push_back(make_shared<PatternDatabase>(task_proxy, pattern, false, vector<int>(), bound));
+      pattern_databases->push_back(make_shared<PatternDatabase>(task_proxy, pattern, false, vector<int>(), bound, pareto));
       size += pattern_databases->back()->get_size();
     }
     are_additive = compute_additive_vars(task_proxy);
@@ -53,6 +54,26 @@ int IncrementalCanonicalPDBs::get_value(const State &state) const {
     return canonical_pdbs.get_value(state);
 }
 
+int IncrementalCanonicalPDBs::get_value(
+    const State &state, int g, int bound, const string &objective,
+    const string &aggregate) const {
+    CanonicalPDBs canonical_pdbs(pattern_databases, max_additive_subsets,
+                                 false, true, objective, aggregate);
+    return canonical_pdbs.get_value(state, g, bound, 0, nullptr);
+}
+
+CanonicalPDBs IncrementalCanonicalPDBs::get_canonical_pdbs_with_pdb(
+    const shared_ptr<PatternDatabase> &pdb, const string &objective,
+    const string &aggregate) const {
+    shared_ptr<PDBCollection> extended_pdbs =
+        make_shared<PDBCollection>(*pattern_databases);
+    extended_pdbs->push_back(pdb);
+    shared_ptr<MaxAdditivePDBSubsets> extended_subsets =
+        compute_max_additive_subsets(*extended_pdbs, are_additive);
+    return CanonicalPDBs(extended_pdbs, extended_subsets, false, true,
+                         objective, aggregate);
+}
+
 bool IncrementalCanonicalPDBs::is_dead_end(const State &state) const {
     for (const shared_ptr<PatternDatabase> &pdb : *pattern_databases)
         if (pdb->get_value(state) == numeric_limits<int>::max())
@@ -8,8 +8,11 @@
 #include "../task_proxy.h"
 
 #include <memory>
+#include <string>
 
 namespace pdbs {
+class CanonicalPDBs;
+
 class IncrementalCanonicalPDBs {
     TaskProxy task_proxy;
 
@@ -26,7 +29,8 @@ class IncrementalCanonicalPDBs {
     void recompute_max_additive_subsets();
 public:
     IncrementalCanonicalPDBs(const TaskProxy &task_proxy,
-                             const PatternCollection &intitial_patterns, const int bound);
+                             const PatternCollection &intitial_patterns, const int bound,
+                             bool pareto = false);
     virtual ~IncrementalCanonicalPDBs() = default;
 
     void add_pdb_for_pattern(const Pattern &pattern);
@@ -39,6 +43,25 @@ public:
 
     int get_value(const State &state) const;
 
+    /*
+      Value of the pareto objective for a state reached with cost g
+      under the given cost bound, as computed by cpdbs(pareto=true).
+      The PDBs must have their pareto fronts. Expected work assumes a
+      branching factor of 1.
+    */
+    int get_value(const State &state, int g, int bound,
+                  const std::string &objective,
+                  const std::string &aggregate) const;
+
+    /*
+      Returns the canonical heuristic of the collection with pdb added
+      for the given pareto objective, without changing the collection.
+    */
+    CanonicalPDBs get_canonical_pdbs_with_pdb(
+        const std::shared_ptr<PatternDatabase> &pdb,
+        const std::string &objective,
+        const std::string &aggregate) const;
+
     /*
       The following method offers a quick dead-end check for the sampling
       procedure of iPDB-hillclimbing. This exists because we can much more
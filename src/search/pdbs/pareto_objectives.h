@@ -0,0 +1,88 @@
+#ifndef PDBS_PARETO_OBJECTIVES_H
+#define PDBS_PARETO_OBJECTIVES_H
+
+#include <algorithm>
+#include <cmath>
+
+namespace pdbs {
+/*
+  Compile-time policies for CanonicalPDBs. An objective maps a pair
+  (h, d) of a Pareto front to a value to be minimised, given the
+  g-value, the cost bound and the estimated branching factor b of the
+  search. An aggregate combines the minimised values of the additive
+  subsets. CanonicalPDBs instantiates its evaluation for every
+  combination and picks one at construction, so the objective and the
+  aggregate are inlined into the loops over fronts and subsets.
+
+  LOOKUP says which pair of a front pruned to the budget bound - g
+  minimises the objective, if that does not depend on g, bound or b.
+*/
+enum class BudgetLookup {NONE, MIN_D, MIN_H};
+
+namespace objectives {
+// Fraction of the remaining budget left after spending h of it.
+inline double get_potential(int h, int g, int bound) {
+    if (h > bound - g)
+        return 0;
+    if (h == 0)
+        return 1;
+    return 1 - (h / (double) (bound + 1 - g));
+}
+
+struct Distance {
+    static const BudgetLookup LOOKUP = BudgetLookup::MIN_D;
+    static const bool USES_B = false;
+    static double evaluate(int /*h*/, int d, int /*g*/, int /*bound*/, int /*b*/) {
+        return d;
+    }
+};
+
+struct HeuristicValue {
+    static const BudgetLookup LOOKUP = BudgetLookup::MIN_H;
+    static const bool USES_B = false;
+    static double evaluate(int h, int /*d*/, int /*g*/, int /*bound*/, int /*b*/) {
+        return h;
+    }
+};
+
+// Potential search: minimise the inverse potential.
+struct Potential {
+    static const BudgetLookup LOOKUP = BudgetLookup::MIN_H;
+    static const bool USES_B = false;
+    static double evaluate(int h, int /*d*/, int g, int bound, int /*b*/) {
+        return 1 / get_potential(h, g, bound);
+    }
+};
+
+// Expected work: b^d expansions weighted by the inverse potential.
+struct ExpectedWork {
+    static const BudgetLookup LOOKUP = BudgetLookup::NONE;
+    static const bool USES_B = true;
+    static double evaluate(int h, int d, int g, int bound, int b) {
+        return pow(d, b) / get_potential(h, g, bound);
+    }
+};
+}
+
+namespace aggregates {
+struct Sum {
+    static double combine(double total, double value) {
+        return total + value;
+    }
+};
+
+struct Max {
+    static double combine(double total, double value) {
+        return std::max(total, value);
+    }
+};
+
+struct Min {
+    static double combine(double total, double value) {
+        return std::min(total, value);
+    }
+};
+}
+}
+
+#endif
@@ -1,8 +1,10 @@
 #include "pattern_collection_generator_hillclimbing.h"
 
+#include "canonical_pdbs.h"
 #include "canonical_pdbs_heuristic.h"
 #include "incremental_canonical_pdbs.h"
 #include "pattern_database.h"
+#include "pdb_builder.h"
 #include "validation.h"
 
 #include "../causal_graph.h"
@@ -16,9 +18,11 @@
 #include "../utils/markup.h"
 #include "../utils/math.h"
 #include "../utils/memory.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <exception>
 #include <iostream>
@@ -36,6 +40,13 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(c
       min_improvement(opts.get<int>("min_improvement")),
       max_time(opts.get<double>("max_time")),
       bound(opts.get<int>("bound")),
+      construction_bound(opts.get<bool>("bound_independent") ?
+                         DijkstraSearch::INF : bound),
+      pareto(opts.get<bool>("pareto") ||
+             opts.get<string>("scoring_objective") != "none"),
+      num_threads(opts.get<int>("threads")),
+      scoring_objective(opts.get<string>("scoring_objective")),
+      scoring_aggregate(opts.get<string>("scoring_aggregate")),
       num_rejected(0),
       hill_climbing_timer(0) {
 }
@@ -75,7 +86,8 @@ void PatternCollectionGeneratorHillclimbing::generate_candidate_patterns(
 
 size_t PatternCollectionGeneratorHillclimbing::generate_pdbs_for_candidates(
     const TaskProxy &task_proxy, set<Pattern> &generated_patterns,
-    PatternCollection &new_candidates, PDBCollection &candidate_pdbs) const {
+    PatternCollection &new_candidates, PDBCollection &candidate_pdbs,
+    vector<PDBJob> &new_pdb_jobs) const {
     /*
       For the new candidate patterns check whether they already have been
       candidates before and thus already a PDB has been created an inserted into
@@ -84,10 +96,18 @@ size_t PatternCollectionGeneratorHillclimbing::generate_pdbs_for_candidates(
     size_t max_pdb_size = 0;
     for (const Pattern &new_candidate : new_candidates) {
         if (generated_patterns.count(new_candidate) == 0) {
-            candidate_pdbs.push_back(
-				     make_shared<PatternDatabase>(task_proxy, new_candidate, false, vector<int>(), bound));
-            max_pdb_size = max(max_pdb_size,
-                               candidate_pdbs.back()->get_size());
+            size_t num_states =
+                compute_num_abstract_states(task_proxy, new_candidate);
+            size_t index = candidate_pdbs.size();
+            candidate_pdbs.push_back(nullptr);
+            new_pdb_jobs.emplace_back(
+                new_candidate, num_states,
+                [this, &task_proxy, &candidate_pdbs, index, new_candidate]() {
+                    candidate_pdbs[index] = make_shared<PatternDatabase>(
+                        task_proxy, new_candidate, false, vector<int>(),
+                        construction_bound, pareto);
+                });
+            max_pdb_size = max(max_pdb_size, num_states);
             generated_patterns.insert(new_candidate);
         }
     }
@@ -96,10 +116,18 @@ size_t PatternCollectionGeneratorHillclimbing::generate_pdbs_for_candidates(
 
 void PatternCollectionGeneratorHillclimbing::sample_states(
     const TaskProxy &task_proxy, const SuccessorGenerator &successor_generator,
-    vector<State> &samples, double average_operator_cost) {
+    vector<State> &samples, vector<int> &samples_g_values,
+    double average_operator_cost) {
     int init_h = current_pdbs->get_value(
         task_proxy.get_initial_state());
 
+    function<bool(const State &, int)> is_out_of_bound;
+    if (scoring_objective != "none") {
+        is_out_of_bound = [this](const State &state, int g) {
+            return evaluate_sample(state, g) == numeric_limits<int>::max();
+        };
+    }
+
     try {
         samples = sample_states_with_random_walks(
             task_proxy, successor_generator, num_samples, init_h,
@@ -107,14 +135,24 @@ void PatternCollectionGeneratorHillclimbing::sample_states(
             [this](const State &state) {
                 return current_pdbs->is_dead_end(state);
             },
-            hill_climbing_timer);
+            hill_climbing_timer, &samples_g_values, is_out_of_bound);
     } catch (SamplingTimeout &) {
         throw HillClimbingTimeout();
     }
 }
 
+int PatternCollectionGeneratorHillclimbing::evaluate_sample(
+    const State &sample, int g) const {
+    if (scoring_objective == "none")
+        return current_pdbs->get_value(sample);
+    return current_pdbs->get_value(
+        sample, g, bound, scoring_objective, scoring_aggregate);
+}
+
 pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
-    vector<State> &samples, PDBCollection &candidate_pdbs) {
+    const vector<State> &samples, const vector<int> &samples_g_values,
+    const vector<int> &samples_h_values, PDBCollection &candidate_pdbs,
+    vector<PDBJob> &new_pdb_jobs) {
     /*
       TODO: The original implementation by Haslum et al. uses A* to compute
       h values for the sample states only instead of generating all PDBs.
@@ -122,30 +160,33 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
       We require that a pattern must have an improvement of at least one in
       order to be taken into account.
     */
-    int improvement = 0;
-    int best_pdb_index = -1;
-
-    // Iterate over all candidates and search for the best improving pattern/pdb
-    for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-      
-        if (hill_climbing_timer->is_expired())
-            throw HillClimbingTimeout();
+    const size_t num_candidates = candidate_pdbs.size();
+    const size_t num_built = num_candidates - new_pdb_jobs.size();
+    // Number of improved samples per candidate, -1 if it was not evaluated.
+    vector<int> counts(num_candidates, -1);
+    atomic<bool> timed_out(false);
+
+    auto evaluate_candidate = [&](size_t i) {
+        if (timed_out || hill_climbing_timer->is_expired()) {
+            timed_out = true;
+            return;
+        }
 
-        const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
+        shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
         if (!pdb) {
             /* candidate pattern is too large or has already been added to
                the canonical heuristic. */
-            continue;
+            return;
         }
-	
+
         /*
           If a candidate's size added to the current collection's size exceeds
           the maximum collection size, then forget the pdb.
         */
         int combined_size = current_pdbs->get_size() + pdb->get_size();
         if (combined_size > collection_max_size) {
-            candidate_pdbs[i] = nullptr;
-            continue;
+            pdb = nullptr;
+            return;
         }
 
         /*
@@ -159,21 +200,71 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
           see above) earlier.
         */
         int count = 0;
-	
-        MaxAdditivePDBSubsets max_additive_subsets =
-            current_pdbs->get_max_additive_subsets(pdb->get_pattern());
-	
-        for (State &sample : samples) {
-            if (is_heuristic_improved(*pdb, sample, max_additive_subsets))
-                ++count;
+
+        if (scoring_objective == "none") {
+            MaxAdditivePDBSubsets max_additive_subsets =
+                current_pdbs->get_max_additive_subsets(pdb->get_pattern());
+
+            for (size_t j = 0; j < samples.size(); ++j) {
+                if (is_heuristic_improved(*pdb, samples[j], samples_h_values[j],
+                                          max_additive_subsets))
+                    ++count;
+            }
+        } else {
+            CanonicalPDBs extended_pdbs =
+                current_pdbs->get_canonical_pdbs_with_pdb(
+                    pdb, scoring_objective, scoring_aggregate);
+
+            for (size_t j = 0; j < samples.size(); ++j) {
+                if (is_objective_improved(extended_pdbs, samples[j],
+                                          samples_g_values[j],
+                                          samples_h_values[j]))
+                    ++count;
+            }
         }
+        counts[i] = count;
+    };
 
+    /*
+      Every thread takes the next candidate that is already built until
+      none is left, so threads that finish early take over the work of
+      the others.
+    */
+    atomic<size_t> next_candidate(0);
+    for (int i = 0; i < thread_pool->get_num_threads(); ++i) {
+        thread_pool->submit([&]() {
+                                size_t index;
+                                while ((index = next_candidate++) < num_built)
+                                    evaluate_candidate(index);
+                            });
+    }
+
+    // New candidates are evaluated by the job that builds them.
+    for (size_t i = 0; i < new_pdb_jobs.size(); ++i) {
+        size_t index = num_built + i;
+        new_pdb_jobs[i].after_build = [&evaluate_candidate, index]() {
+            evaluate_candidate(index);
+        };
+    }
+    if (!new_pdb_jobs.empty()) {
+        run_pdb_jobs(*thread_pool, new_pdb_jobs, false,
+                     [&timed_out]() {return timed_out.load(); });
+    }
+    thread_pool->wait();
+
+    if (timed_out)
+        throw HillClimbingTimeout();
+
+    int improvement = 0;
+    int best_pdb_index = -1;
+    for (size_t i = 0; i < num_candidates; ++i) {
+        int count = counts[i];
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
         }
         if (count > 0) {
-            cout << "pattern: " << pdb->get_pattern()
+            cout << "pattern: " << candidate_pdbs[i]->get_pattern()
                  << " - improvement: " << count << endl;
         }
     }
@@ -182,16 +273,11 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
 }
 
 bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
-    const PatternDatabase &pdb, const State &sample,
-    const MaxAdditivePDBSubsets &max_additive_subsets) {
+    const PatternDatabase &pdb, const State &sample, int h_collection,
+    const MaxAdditivePDBSubsets &max_additive_subsets) const {
     // h_pattern: h-value of the new pattern
     int h_pattern = pdb.get_value(sample);
 
-    
-
-    // h_collection: h-value of the current collection heuristic
-    int h_collection = current_pdbs->get_value(sample);
-    
     if (h_collection == numeric_limits<int>::max())
         return false;
 
@@ -220,12 +306,22 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
     return false;
 }
 
+bool PatternCollectionGeneratorHillclimbing::is_objective_improved(
+    const CanonicalPDBs &extended_pdbs, const State &sample, int g,
+    int value_collection) const {
+    if (value_collection == numeric_limits<int>::max())
+        return false;
+    int value = extended_pdbs.get_value(sample, g, bound, 0, nullptr);
+    return value > value_collection;
+}
+
 void PatternCollectionGeneratorHillclimbing::hill_climbing(
     const TaskProxy &task_proxy,
     const SuccessorGenerator &successor_generator,
     double average_operator_cost,
     PatternCollection &initial_candidate_patterns) {
     hill_climbing_timer = new utils::CountdownTimer(max_time);
+    thread_pool = utils::make_unique_ptr<utils::ThreadPool>(num_threads);
     // Candidate patterns generated so far (used to avoid duplicates).
     set<Pattern> generated_patterns;
     /* Set of new pattern candidates from the last call to
@@ -250,16 +346,30 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
                      << endl;
             }
 
+            vector<PDBJob> new_pdb_jobs;
             size_t new_max_pdb_size = generate_pdbs_for_candidates(
-                task_proxy, generated_patterns, new_candidates, candidate_pdbs);
+                task_proxy, generated_patterns, new_candidates, candidate_pdbs,
+                new_pdb_jobs);
             max_pdb_size = max(max_pdb_size, new_max_pdb_size);
 
             vector<State> samples;
+            vector<int> samples_g_values;
             sample_states(
-                task_proxy, successor_generator, samples, average_operator_cost);
+                task_proxy, successor_generator, samples, samples_g_values,
+                average_operator_cost);
+
+            // The values of the current collection do not change until
+            // the best candidate is added.
+            vector<int> samples_h_values;
+            samples_h_values.reserve(samples.size());
+            for (size_t i = 0; i < samples.size(); ++i) {
+                samples_h_values.push_back(
+                    evaluate_sample(samples[i], samples_g_values[i]));
+            }
 
-            pair<int, int> improvement_and_index =
-                find_best_improving_pdb(samples, candidate_pdbs);
+            pair<int, int> improvement_and_index = find_best_improving_pdb(
+                samples, samples_g_values, samples_h_values, candidate_pdbs,
+                new_pdb_jobs);
             int improvement = improvement_and_index.first;
             int best_pdb_index = improvement_and_index.second;
 
@@ -305,6 +415,7 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
 
     delete hill_climbing_timer;
     hill_climbing_timer = nullptr;
+    thread_pool = nullptr;
 }
 
 PatternCollectionInformation PatternCollectionGeneratorHillclimbing::generate(
@@ -324,7 +435,7 @@ PatternCollectionInformation PatternCollectionGeneratorHillclimbing::generate(
         initial_pattern_collection.emplace_back(1, goal_var_id);
     }
     current_pdbs = utils::make_unique_ptr<IncrementalCanonicalPDBs>(
-								    task_proxy, initial_pattern_collection, bound);
+								    task_proxy, initial_pattern_collection, construction_bound, pareto);
 
     State initial_state = task_proxy.get_initial_state();
     if (!current_pdbs->is_dead_end(initial_state)) {
@@ -390,6 +501,45 @@ void add_hillclimbing_options(OptionParser &parser) {
         "Cost Bound.",
         "infinity",
         Bounds("-1", "infinity"));
+    parser.add_option<bool>(
+        "pareto",
+        "Compute the pareto fronts of all PDBs during their construction, "
+        "so that cpdbs(pareto=true) does not have to build the selected "
+        "PDBs a second time.",
+        "false");
+    parser.add_option<bool>(
+        "bound_independent",
+        "Build the PDBs without truncating their pareto fronts at the cost "
+        "bound. The bound is then only used to select the patterns, and "
+        "the PDBs give correct values for every search bound, e.g. for all "
+        "phases of an iterated search with pass_bound=true. The fronts can "
+        "be much larger.",
+        "false");
+    parser.add_option<int>(
+        "threads",
+        "Number of threads for building the candidate PDBs. The number of "
+        "PDBs built at the same time is also limited by the memory limit.",
+        "1",
+        Bounds("1", "infinity"));
+    parser.add_option<string>(
+        "scoring_objective",
+        "Pareto objective (h, d, pts or ework) for scoring the candidate "
+        "patterns: a sample counts as improved if the objective of "
+        "cpdbs(pareto=true) at the cost of the random walk that reached it "
+        "and the cost bound is higher with the candidate. The random walks "
+        "end before the first state that the current collection proves to "
+        "be out of the bound. With none, candidates are scored on h as in "
+        "the original algorithm. Implies pareto=true.",
+        "none");
+    parser.add_option<string>(
+        "scoring_aggregate",
+        "Aggregate (sum, max or min) of the scoring objective over the "
+        "additive subsets. With sum, scoring degenerates: adding a "
+        "candidate adds or extends additive subsets, which raises the sum "
+        "on nearly every sample, so most candidates improve all samples. "
+        "The first of them in candidate order is then chosen, and hill "
+        "climbing usually runs until max_time.",
+        "max");
 }
 
 void check_hillclimbing_options(
@@ -397,6 +547,13 @@ void check_hillclimbing_options(
     if (opts.get<int>("min_improvement") > opts.get<int>("num_samples"))
         parser.error("minimum improvement must not be higher than number of "
                      "samples");
+    const string objective = opts.get<string>("scoring_objective");
+    if (objective != "none" && objective != "h" && objective != "d" &&
+        objective != "pts" && objective != "ework")
+        parser.error("unknown scoring objective: " + objective);
+    const string aggregate = opts.get<string>("scoring_aggregate");
+    if (aggregate != "sum" && aggregate != "max" && aggregate != "min")
+        parser.error("unknown scoring aggregate: " + aggregate);
 }
 
 static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
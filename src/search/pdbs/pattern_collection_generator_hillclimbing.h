@@ -10,6 +10,7 @@
 #include <cstdlib>
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
 namespace options {
@@ -18,12 +19,15 @@ class Options;
 
 namespace utils {
 class CountdownTimer;
+class ThreadPool;
 }
 
 namespace pdbs {
+class CanonicalPDBs;
 class CanonicalPDBsHeuristic;
 class IncrementalCanonicalPDBs;
 class PatternDatabase;
+struct PDBJob;
 
 // Implementation of the pattern generation algorithm by Haslum et al.
 class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator {
@@ -36,8 +40,24 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     const int min_improvement;
     const double max_time;
     const int bound;
+    /*
+      Cost bound the PDBs are built with: bound, or infinity if the
+      PDBs should serve every bound.
+    */
+    const int construction_bound;
+    // build all PDBs with their pareto fronts
+    const bool pareto;
+    const int num_threads;
+    /*
+      Pareto objective and aggregate for scoring the candidates on the
+      samples, or "none" to score them on h.
+    */
+    const std::string scoring_objective;
+    const std::string scoring_aggregate;
 
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
+    // builds and evaluates the candidate PDBs during hill climbing
+    std::unique_ptr<utils::ThreadPool> thread_pool;
 
     // for stats only
     int num_rejected;
@@ -54,14 +74,18 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
         PatternCollection &candidate_patterns);
 
     /*
-      Generates the PatternDatabase for patterns in new_candidates if they have
-      not been generated already.
+      Appends an empty slot to candidate_pdbs for each pattern in
+      new_candidates that has not been generated already, and a job to
+      new_pdb_jobs that builds the PatternDatabase into that slot. The
+      jobs are run by find_best_improving_pdb. Returns the size of the
+      largest new PDB.
     */
     std::size_t generate_pdbs_for_candidates(
         const TaskProxy &task_proxy,
         std::set<Pattern> &generated_patterns,
         PatternCollection &new_candidates,
-        PDBCollection &candidate_pdbs) const;
+        PDBCollection &candidate_pdbs,
+        std::vector<PDBJob> &new_pdb_jobs) const;
 
     /*
       Performs num_samples random walks with a length (different for each
@@ -77,27 +101,56 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
         const TaskProxy &task_proxy,
         const SuccessorGenerator &successor_generator,
         std::vector<State> &samples,
+        std::vector<int> &samples_g_values,
         double average_operator_cost);
 
+    // Value of the current collection for a sample reached with cost g.
+    int evaluate_sample(const State &sample, int g) const;
+
     /*
       Searches for the best improving pdb in candidate_pdbs according to the
-      counting approximation and the given samples. Returns the improvement and
-      the index of the best pdb in candidate_pdbs.
+      counting approximation and the given samples. samples_h_values holds
+      the value of the current collection for each sample (see
+      evaluate_sample). Returns the improvement and the index of the best
+      pdb in candidate_pdbs.
+
+      The candidates are evaluated in parallel. The last new_pdb_jobs.size()
+      entries of candidate_pdbs are not built yet: each of them is evaluated
+      right after its job has built it, so the other threads keep evaluating
+      while PDBs are built. The result does not depend on the number of
+      threads.
     */
     std::pair<int, int> find_best_improving_pdb(
-        std::vector<State> &samples,
-        PDBCollection &candidate_pdbs);
+        const std::vector<State> &samples,
+        const std::vector<int> &samples_g_values,
+        const std::vector<int> &samples_h_values,
+        PDBCollection &candidate_pdbs,
+        std::vector<PDBJob> &new_pdb_jobs);
 
     /*
       Returns true iff the h-value of the new pattern (from pdb) plus the
       h-value of all maximal additive subsets from the current pattern
       collection heuristic if the new pattern was added to it is greater than
-      the h-value of the current pattern collection.
+      the h-value h_collection of the current pattern collection.
     */
     bool is_heuristic_improved(
         const PatternDatabase &pdb,
         const State &sample,
-        const MaxAdditivePDBSubsets &max_additive_subsets);
+        int h_collection,
+        const MaxAdditivePDBSubsets &max_additive_subsets) const;
+
+    /*
+      Returns true iff the value of the scoring objective for the sample,
+      reached with cost g, is higher with the new pattern
+      (extended_pdbs) than the value value_collection of the current
+      pattern collection, or the new pattern proves the sample to be out
+      of the bound. Higher values are more informed for all objectives.
+    */
+    bool is_objective_improved(
+        const CanonicalPDBs &extended_pdbs,
+        const State &sample,
+        int g,
+        int value_collection) const;
 
     /*
       This is the core algorithm of this class. As soon as after an iteration,
@@ -2,8 +2,11 @@
 
 #include "pattern_database.h"
 #include "max_additive_pdb_sets.h"
+#include "pdb_builder.h"
 #include "validation.h"
 
+#include "../utils/thread_pool.h"
+
 #include <algorithm>
 #include <cassert>
 #include <unordered_set>
@@ -18,7 +21,9 @@ PatternCollectionInformation::PatternCollectionInformation(
     : task_proxy(task_proxy),
       patterns(patterns),
       pdbs(nullptr),
-      max_additive_subsets(nullptr) {
+      max_additive_subsets(nullptr),
+      pareto(false),
+      num_threads(1) {
     assert(patterns);
     validate_and_normalize_patterns(task_proxy, *patterns);
 }
@@ -70,12 +75,21 @@ bool PatternCollectionInformation::information_is_valid() const {
 void PatternCollectionInformation::create_pdbs_if_missing() {
     assert(patterns);
     if (!pdbs) {
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern);
-            pdbs->push_back(pdb);
+        pdbs = make_shared<PDBCollection>(patterns->size());
+        vector<PDBJob> jobs;
+        jobs.reserve(patterns->size());
+        for (size_t i = 0; i < patterns->size(); ++i) {
+            const Pattern &pattern = (*patterns)[i];
+            jobs.emplace_back(
+                pattern, compute_num_abstract_states(task_proxy, pattern),
+                [this, i, &pattern]() {
+                    (*pdbs)[i] = make_shared<PatternDatabase>(
+                        task_proxy, pattern, false, vector<int>(),
+                        DijkstraSearch::INF, pareto, false, pdb_cache.get());
+                });
         }
+        utils::ThreadPool pool(num_threads);
+        run_pdb_jobs(pool, jobs, true);
     }
 }
 
@@ -8,6 +8,8 @@
 #include <memory>
 
 namespace pdbs {
+class PDBCache;
+
 /*
   This class contains everything we know about a pattern collection. It will
   always contain patterns, but can also contain the computed PDBs and maximal
@@ -22,6 +24,9 @@ class PatternCollectionInformation {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
+    bool pareto;
+    int num_threads;
+    std::shared_ptr<PDBCache> pdb_cache;
 
     void create_pdbs_if_missing();
     void create_max_additive_subsets_if_missing();
@@ -37,6 +42,24 @@ public:
     void set_max_additive_subsets(
         const std::shared_ptr<MaxAdditivePDBSubsets> &max_additive_subsets);
 
+    /*
+      If set before the PDBs are created, they compute their Pareto
+      fronts during construction instead of in a second pass.
+    */
+    void set_pareto(bool pareto_) {
+        pareto = pareto_;
+    }
+
+    // Number of threads used to create the PDBs.
+    void set_num_threads(int num_threads_) {
+        num_threads = num_threads_;
+    }
+
+    // On-disk cache the PDBs are loaded from or stored in, if set.
+    void set_pdb_cache(const std::shared_ptr<PDBCache> &pdb_cache_) {
+        pdb_cache = pdb_cache_;
+    }
+
     std::shared_ptr<PatternCollection> get_patterns();
     std::shared_ptr<PDBCollection> get_pdbs();
     std::shared_ptr<MaxAdditivePDBSubsets> get_max_additive_subsets();
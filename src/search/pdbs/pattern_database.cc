@@ -1,6 +1,7 @@
 #include "pattern_database.h"
 
 #include "match_tree.h"
+#include "pdb_cache.h"
 
 #include "../priority_queue.h"
 #include "../task_tools.h"
@@ -13,10 +14,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -73,8 +76,11 @@ PatternDatabase::PatternDatabase(
     const Pattern &pattern,
     bool dump,
     const vector<int> &operator_costs,
-    const int bound)
-  : pattern(pattern), dijkstra_search(bound) {
+    const int bound,
+    bool pareto,
+    bool forward_pruning,
+    const PDBCache *cache)
+  : pattern(pattern), dijkstra_search(bound), forward_pruned(false) {
     verify_no_axioms(task_proxy);
     verify_no_conditional_effects(task_proxy);
     assert(operator_costs.empty() ||
@@ -97,7 +103,8 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::CRITICAL_ERROR);
         }
     }
-    create_pdb(task_proxy, operator_costs);
+    create_or_load_pdb(task_proxy, operator_costs, pareto, forward_pruning,
+                       cache);
     if (dump)
         cout << "PDB construction time: " << timer << endl;
 }
@@ -108,13 +115,20 @@ void PatternDatabase::multiply_out(
     vector<FactPair> &eff_pairs,
     const vector<FactPair> &effects_without_pre,
     const VariablesProxy &variables,
-    vector<AbstractOperator> &operators) {
+    vector<AbstractOperator> &operators,
+    bool progression) {
     if (pos == static_cast<int>(effects_without_pre.size())) {
         // All effects without precondition have been checked: insert op.
         if (!eff_pairs.empty()) {
-            operators.push_back(
-                AbstractOperator(prev_pairs, pre_pairs, eff_pairs, cost,
-                                 hash_multipliers));
+            if (progression) {
+                operators.push_back(
+                    AbstractOperator(prev_pairs, eff_pairs, pre_pairs, cost,
+                                     hash_multipliers));
+            } else {
+                operators.push_back(
+                    AbstractOperator(prev_pairs, pre_pairs, eff_pairs, cost,
+                                     hash_multipliers));
+            }
         }
     } else {
         // For each possible value for the current variable, build an
@@ -130,7 +144,8 @@ void PatternDatabase::multiply_out(
                 prev_pairs.emplace_back(var_id, i);
             }
             multiply_out(pos + 1, cost, prev_pairs, pre_pairs, eff_pairs,
-                         effects_without_pre, variables, operators);
+                         effects_without_pre, variables, operators,
+                         progression);
             if (i != eff) {
                 pre_pairs.pop_back();
                 eff_pairs.pop_back();
@@ -145,7 +160,8 @@ void PatternDatabase::build_abstract_operators(
     const OperatorProxy &op, int cost,
     const vector<int> &variable_to_index,
     const VariablesProxy &variables,
-    vector<AbstractOperator> &operators) {
+    vector<AbstractOperator> &operators,
+    bool progression) {
     // All variable value pairs that are a prevail condition
     vector<FactPair> prev_pairs;
     // All variable value pairs that are a precondition (value != -1)
@@ -188,11 +204,50 @@ void PatternDatabase::build_abstract_operators(
         }
     }
     multiply_out(0, cost, prev_pairs, pre_pairs, eff_pairs, effects_without_pre,
-                 variables, operators);
+                 variables, operators, progression);
+}
+
+/*
+  Regression graph of the abstract state space: the predecessors of
+  each abstract state under the operators stored in match_tree.
+*/
+static DijkstraSearch::TransitionGraph build_regression_graph(
+    const MatchTree &match_tree, size_t num_states) {
+    DijkstraSearch::TransitionGraph graph;
+    vector<const AbstractOperator *> applicable_operators;
+    for (size_t state_index = 0; state_index < num_states; ++state_index) {
+        applicable_operators.clear();
+        match_tree.get_applicable_operators(state_index, applicable_operators);
+        for (const AbstractOperator *op : applicable_operators) {
+            graph.add_transition(state_index + op->get_hash_effect(),
+                                 op->get_cost());
+        }
+        graph.close_state();
+    }
+    return graph;
+}
+
+/*
+  Transitions of a single abstract state under the operators stored in
+  match_tree, for sweeps that generate them on demand.
+*/
+static vector<DijkstraSearch::Successor> get_transitions(
+    const MatchTree &match_tree, size_t state_index) {
+    vector<const AbstractOperator *> applicable_operators;
+    match_tree.get_applicable_operators(state_index, applicable_operators);
+    vector<DijkstraSearch::Successor> transitions;
+    transitions.reserve(applicable_operators.size());
+    for (const AbstractOperator *op : applicable_operators) {
+        transitions.emplace_back(state_index + op->get_hash_effect(),
+                                 op->get_cost());
+    }
+    return transitions;
 }
 
 void PatternDatabase::create_pdb(
-    const TaskProxy &task_proxy, const vector<int> &operator_costs) {
+    const TaskProxy &task_proxy, const vector<int> &operator_costs,
+    bool pareto, bool forward_pruning) {
+    const bool prune = pareto && forward_pruning && dijkstra_search.is_bounded();
     VariablesProxy variables = task_proxy.get_variables();
     vector<int> variable_to_index(variables.size(), -1);
     for (size_t i = 0; i < pattern.size(); ++i) {
@@ -201,6 +256,8 @@ void PatternDatabase::create_pdb(
 
     // compute all abstract operators
     vector<AbstractOperator> operators;
+    vector<AbstractOperator> progression_operators;
+    int max_cost = 0;
     for (OperatorProxy op : task_proxy.get_operators()) {
         int op_cost;
         if (operator_costs.empty()) {
@@ -208,8 +265,14 @@ void PatternDatabase::create_pdb(
         } else {
             op_cost = operator_costs[op.get_id()];
         }
+        max_cost = max(max_cost, op_cost);
         build_abstract_operators(
             op, op_cost, variable_to_index, variables, operators);
+        if (prune) {
+            build_abstract_operators(
+                op, op_cost, variable_to_index, variables,
+                progression_operators, true);
+        }
     }
 
     // build the match tree
@@ -235,89 +298,106 @@ void PatternDatabase::create_pdb(
       }
     }
 
-    auto predecessors = [&match_tree] (const size_t state_id) {
-      vector<const AbstractOperator *> applicable_operators;
-      match_tree.get_applicable_operators(state_id, applicable_operators);
-      vector< DijkstraSearch::Successor > predecessors;
-      for(auto op : applicable_operators) {
-	predecessors.push_back(
-			       DijkstraSearch::Successor(state_id + op->get_hash_effect(),
-							 op->get_cost()));
-      }
-      return predecessors;
-    };
-    
-    dijkstra_search.init(DijkstraSearch::BACKWARD,
-    			 predecessors, goal_states,
-			 num_states);
-
-    dijkstra_search.compute(DijkstraSearch::BACKWARD,
-			   DijkstraSearch::ORDINARY);
-
-}
-
-  void PatternDatabase::compute_backward_pareto_fronts(const TaskProxy &task_proxy,
-						       const vector<int> &operator_costs) {
-    VariablesProxy variables = task_proxy.get_variables();
-    vector<int> variable_to_index(variables.size(), -1);
-    for (size_t i = 0; i < pattern.size(); ++i) {
-        variable_to_index[pattern[i]] = i;
+    if (!prune) {
+      /*
+	A Pareto sweep also yields the ordinary distances (the minimum h
+	of each front), so one sweep suffices in pareto mode. If the
+	ordinary distances already exist, it continues from them.
+      */
+      dijkstra_search.init(DijkstraSearch::BACKWARD,
+			   build_regression_graph(match_tree, num_states),
+			   goal_states);
+      dijkstra_search.compute(DijkstraSearch::BACKWARD,
+			      pareto ? DijkstraSearch::PARETO :
+			      DijkstraSearch::ORDINARY);
+      dijkstra_search.release_transitions(DijkstraSearch::BACKWARD);
+      return;
     }
 
-    // compute all abstract operators
-    vector<AbstractOperator> operators;
-    for (OperatorProxy op : task_proxy.get_operators()) {
-        int op_cost;
-        if (operator_costs.empty()) {
-            op_cost = op.get_cost();
-        } else {
-            op_cost = operator_costs[op.get_id()];
-        }
-        build_abstract_operators(
-            op, op_cost, variable_to_index, variables, operators);
+    /*
+      The forward sweep is informed by the ordinary backward distances,
+      so it only reaches states with g + h <= bound. The backward sweep
+      is then restarted from the goals and, informed by the forward
+      distances, only keeps pairs with g + h <= bound. Both generate
+      transitions on demand instead of building the graph of the whole
+      abstract state space.
+    */
+    if (!dijkstra_search.is_computed(DijkstraSearch::BACKWARD,
+				     DijkstraSearch::ORDINARY)) {
+      dijkstra_search.init(DijkstraSearch::BACKWARD,
+			   build_regression_graph(match_tree, num_states),
+			   goal_states);
+      dijkstra_search.compute(DijkstraSearch::BACKWARD,
+			      DijkstraSearch::ORDINARY);
+      dijkstra_search.release_transitions(DijkstraSearch::BACKWARD);
     }
 
-    // build the match tree
-    MatchTree match_tree(task_proxy, pattern, hash_multipliers);
-    for (const AbstractOperator &op : operators) {
-        match_tree.insert(op);
+    MatchTree progression_match_tree(task_proxy, pattern, hash_multipliers);
+    for (const AbstractOperator &op : progression_operators) {
+      progression_match_tree.insert(op);
     }
+    size_t initial_state = hash_index(task_proxy.get_initial_state());
+    dijkstra_search.init(DijkstraSearch::FORWARD,
+			 [&progression_match_tree] (const size_t state) {
+			   return get_transitions(progression_match_tree, state);
+			 },
+			 vector<size_t>(1, initial_state),
+			 num_states, max_cost);
+    dijkstra_search.compute(DijkstraSearch::FORWARD,
+			    DijkstraSearch::ORDINARY);
+    dijkstra_search.release_transitions(DijkstraSearch::FORWARD);
+
+    dijkstra_search.clear(DijkstraSearch::BACKWARD);
+    dijkstra_search.init(DijkstraSearch::BACKWARD,
+			 [&match_tree] (const size_t state) {
+			   return get_transitions(match_tree, state);
+			 },
+			 goal_states, num_states, max_cost);
+    dijkstra_search.compute(DijkstraSearch::BACKWARD,
+			    DijkstraSearch::PARETO);
+    dijkstra_search.release_transitions(DijkstraSearch::BACKWARD);
 
-    // compute abstract goal var-val pairs
-    vector<FactPair> abstract_goals;
-    for (FactProxy goal : task_proxy.get_goals()) {
-        int var_id = goal.get_variable().get_id();
-        int val = goal.get_value();
-        if (variable_to_index[var_id] != -1) {
-            abstract_goals.emplace_back(variable_to_index[var_id], val);
-        }
-    }
+    // The forward distances are only needed during the sweep.
+    dijkstra_search.clear(DijkstraSearch::FORWARD);
+    forward_pruned = true;
+}
 
-    vector<size_t> goal_states;
-    for (size_t state_index = 0; state_index < num_states; ++state_index) {
-      if (is_goal_state(state_index, abstract_goals, variables)) {
-	goal_states.push_back(state_index);
-      }
+void PatternDatabase::create_or_load_pdb(
+    const TaskProxy &task_proxy, const vector<int> &operator_costs,
+    bool pareto, bool forward_pruning, const PDBCache *cache) {
+    if (!cache) {
+        create_pdb(task_proxy, operator_costs, pareto, forward_pruning);
+        return;
     }
+    uint64_t key = cache->compute_key(
+        task_proxy, pattern, operator_costs, dijkstra_search.get_bound(),
+        pareto, forward_pruning);
+    ParetoFrontTable fronts;
+    if (cache->load(key, fronts)) {
+        dijkstra_search.set_pareto_fronts(
+            DijkstraSearch::BACKWARD, move(fronts),
+            pareto ? DijkstraSearch::PARETO : DijkstraSearch::ORDINARY);
+        forward_pruned =
+            pareto && forward_pruning && dijkstra_search.is_bounded();
+        return;
+    }
+    create_pdb(task_proxy, operator_costs, pareto, forward_pruning);
+    cache->store(key, dijkstra_search.get_pareto_fronts(
+                     DijkstraSearch::BACKWARD));
+}
 
-    auto predecessors = [&match_tree] (const size_t state_id) {
-      vector<const AbstractOperator *> applicable_operators;
-      match_tree.get_applicable_operators(state_id, applicable_operators);
-      vector< DijkstraSearch::Successor > predecessors;
-      for(auto op : applicable_operators) {
-	predecessors.push_back(
-			       DijkstraSearch::Successor(state_id + op->get_hash_effect(),
-							 op->get_cost()));
-      }
-      return predecessors;
-    };
-    
-    dijkstra_search.init(DijkstraSearch::BACKWARD,
-    			 predecessors, goal_states,
-			 num_states);
-
-  dijkstra_search.compute(DijkstraSearch::BACKWARD,
-			  DijkstraSearch::PARETO);
+  void PatternDatabase::compute_backward_pareto_fronts(const TaskProxy &task_proxy,
+						       const vector<int> &operator_costs,
+						       bool forward_pruning,
+						       const PDBCache *cache) {
+    const bool pareto_computed =
+      dijkstra_search.is_computed(DijkstraSearch::BACKWARD,
+				  DijkstraSearch::PARETO);
+    if (pareto_computed &&
+	(forward_pruned || !forward_pruning || !dijkstra_search.is_bounded()))
+      return;
+    create_or_load_pdb(task_proxy, operator_costs, true, forward_pruning,
+		       cache);
 }
   
 bool PatternDatabase::is_goal_state(
@@ -350,8 +430,12 @@ int PatternDatabase::get_value(const State &state) const {
 				   hash_index(state));
 }
 
-  ParetoFront& PatternDatabase::get_backward_pareto_front(const State &state) {
-    return dijkstra_search.get_pareto_front(DijkstraSearch::BACKWARD, hash_index(state));
+  ParetoFrontView PatternDatabase::get_backward_pareto_front(const State &state) const {
+    return get_backward_pareto_front(hash_index(state));
+  }
+
+  ParetoFrontView PatternDatabase::get_backward_pareto_front(size_t index) const {
+    return dijkstra_search.get_pareto_front(DijkstraSearch::BACKWARD, index);
   }
 
 double PatternDatabase::compute_mean_finite_h() const {
@@ -11,6 +11,8 @@
 #include <vector>
 
 namespace pdbs {
+class PDBCache;
+
 class AbstractOperator {
     /*
       This class represents an abstract operator how it is needed for
@@ -80,6 +82,9 @@ class PatternDatabase {
 
     DijkstraSearch dijkstra_search;
 
+    // True iff the Pareto fronts were pruned with forward distances.
+    bool forward_pruned;
+
     // multipliers for each variable for perfect hash function
     std::vector<std::size_t> hash_multipliers;
 
@@ -97,19 +102,24 @@ class PatternDatabase {
         std::vector<FactPair> &eff_pairs,
         const std::vector<FactPair> &effects_without_pre,
         const VariablesProxy &variables,
-        std::vector<AbstractOperator> &operators);
+        std::vector<AbstractOperator> &operators,
+        bool progression);
 
     /*
       Computes all abstract operators for a given concrete operator (by
       its global operator number). Initializes data structures for initial
       call to recursive method multiply_out. variable_to_index maps
       variables in the task to their index in the pattern or -1.
+      If progression is true, preconditions and effects are swapped, so
+      the abstract operators lead from a state to its successors
+      instead of its predecessors.
     */
     void build_abstract_operators(
         const OperatorProxy &op, int cost,
         const std::vector<int> &variable_to_index,
         const VariablesProxy &variables,
-        std::vector<AbstractOperator> &operators);
+        std::vector<AbstractOperator> &operators,
+        bool progression = false);
 
     /*
       Computes all abstract operators, builds the match tree (successor
@@ -117,12 +127,26 @@ class PatternDatabase {
       all final h-values (stored in distances). operator_costs can
       specify individual operator costs for each operator for action
       cost partitioning. If left empty, default operator costs are used.
+      If pareto is true, the regression search computes the Pareto
+      fronts, which include the h-values. See
+      compute_backward_pareto_fronts for forward_pruning.
     */
     void create_pdb(
         const TaskProxy &task_proxy,
-        const std::vector<int> &operator_costs = std::vector<int>());
+        const std::vector<int> &operator_costs = std::vector<int>(),
+        bool pareto = false,
+        bool forward_pruning = false);
 
-    
+    /*
+      Like create_pdb, but first tries to load the result from cache
+      (if not nullptr) and stores it there after computing it.
+    */
+    void create_or_load_pdb(
+        const TaskProxy &task_proxy,
+        const std::vector<int> &operator_costs,
+        bool pareto,
+        bool forward_pruning,
+        const PDBCache *cache);
 
     /*
       For a given abstract state (given as index), the according values
@@ -135,13 +159,14 @@ class PatternDatabase {
         const std::vector<FactPair> &abstract_goals,
         const VariablesProxy &variables) const;
 
+public:
     /*
       The given concrete state is used to calculate the index of the
       according abstract state. This is only used for table lookup
       (distances) during search.
     */
     std::size_t hash_index(const State &state) const;
-public:
+
     /*
       Important: It is assumed that the pattern (passed via Options) is
       sorted, contains no duplicates and is small enough so that the
@@ -151,17 +176,26 @@ public:
        operator_costs: Can specify individual operator costs for each
        operator. This is useful for action cost partitioning. If left
        empty, default operator costs are used.
+       pareto:         If set to true, the Pareto fronts are computed
+       during construction, in the same regression search as the
+       h-values. forward_pruning is passed on to that computation.
+       cache:          If given, the PDB is loaded from this on-disk
+       cache if possible, and stored in it otherwise.
     */
     PatternDatabase(
         const TaskProxy &task_proxy,
         const Pattern &pattern,
         bool dump = false,
         const std::vector<int> &operator_costs = std::vector<int>(),
-	const int bound = DijkstraSearch::INF);
+	const int bound = DijkstraSearch::INF,
+        bool pareto = false,
+        bool forward_pruning = false,
+        const PDBCache *cache = nullptr);
     ~PatternDatabase() = default;
 
     int get_value(const State &state) const;
-    ParetoFront& get_backward_pareto_front(const State &state);
+    ParetoFrontView get_backward_pareto_front(const State &state) const;
+    ParetoFrontView get_backward_pareto_front(std::size_t index) const;
 
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
@@ -183,8 +217,29 @@ public:
     */
     double compute_mean_finite_h() const;
 
+    /*
+      Computes the Pareto fronts of (cost, length) pairs to the goal.
+      With forward_pruning and a finite bound, a forward sweep from the
+      abstract initial state first computes the abstract g-values, and
+      pairs (h, d) of abstract states with g + h > bound are dropped:
+      no plan within the bound passes through a concrete state mapped
+      to them with such a remaining cost. Both sweeps then generate
+      transitions on demand, so only states within the bound are
+      visited.
+      Does nothing if the fronts were already computed, e.g. during
+      construction, unless forward pruning is requested now but was
+      not applied then. If cache is given, the fronts are loaded from
+      it if possible, and stored in it otherwise.
+    */
     void compute_backward_pareto_fronts(const TaskProxy &task_proxy,
-        const std::vector<int> &operator_costs = std::vector<int>());
+        const std::vector<int> &operator_costs = std::vector<int>(),
+        bool forward_pruning = false,
+        const PDBCache *cache = nullptr);
+
+    bool are_backward_pareto_fronts_computed() const {
+        return dijkstra_search.is_computed(DijkstraSearch::BACKWARD,
+                                           DijkstraSearch::PARETO);
+    }
 
     // Returns true iff op has an effect on a variable in the pattern.
     bool is_operator_relevant(const OperatorProxy &op) const;
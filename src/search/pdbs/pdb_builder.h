@@ -0,0 +1,61 @@
+#ifndef PDBS_PDB_BUILDER_H
+#define PDBS_PDB_BUILDER_H
+
+#include "types.h"
+
+#include "../task_proxy.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace utils {
+class ThreadPool;
+}
+
+namespace pdbs {
+/*
+  A job that builds (part of) a PDB for pattern, e.g. by constructing
+  a PatternDatabase or by computing the Pareto fronts of an existing
+  one. num_states is the size of the PDB, from which the memory needed
+  by the job is estimated. If set, after_build is called once the PDB
+  is built, e.g. to evaluate it; it is not part of the construction
+  time.
+*/
+struct PDBJob {
+    Pattern pattern;
+    std::size_t num_states;
+    std::function<void()> build;
+    std::function<void()> after_build;
+
+    PDBJob(const Pattern &pattern, std::size_t num_states,
+           const std::function<void()> &build)
+        : pattern(pattern), num_states(num_states), build(build) {
+    }
+};
+
+/*
+  Runs the jobs on the thread pool and returns once all have finished.
+  The jobs must be independent of each other.
+
+  A job is only started while the estimated memory of all running jobs
+  fits into what is left of the memory limit of the process, so with
+  large PDBs fewer jobs than threads may run at the same time. A job
+  that does not fit on its own is run alone.
+
+  If is_cancelled is set, jobs that have not started when it returns
+  true are skipped.
+
+  If report_each is true, the construction time of each built PDB is
+  printed in the order of the jobs. A summary is printed in any case.
+*/
+extern void run_pdb_jobs(
+    utils::ThreadPool &pool, std::vector<PDBJob> &jobs, bool report_each,
+    const std::function<bool()> &is_cancelled = nullptr);
+
+// Number of abstract states of the PDB for pattern.
+extern std::size_t compute_num_abstract_states(
+    const TaskProxy &task_proxy, const Pattern &pattern);
+}
+
+#endif
@@ -0,0 +1,170 @@
+#include "pdb_cache.h"
+
+#include "../dijkstra_search/pareto_front_table.h"
+
+#include "../utils/memory_mapped_file.h"
+#include "../utils/system.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+namespace pdbs {
+// Changes whenever the file format or the PDB construction changes.
+static const char MAGIC[8] = {'F', 'D', 'P', 'D', 'B', '0', '0', '1'};
+
+struct FileHeader {
+    char magic[8];
+    uint64_t key;
+    uint64_t size_t_size;
+};
+
+// 64-bit FNV-1a, which unlike std::hash is the same on all platforms.
+class KeyHasher {
+    uint64_t hash;
+public:
+    KeyHasher()
+        : hash(14695981039346656037ULL) {
+    }
+
+    void feed(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    void feed(const FactProxy &fact) {
+        feed(fact.get_variable().get_id());
+        feed(fact.get_value());
+    }
+
+    uint64_t get_hash() const {
+        return hash;
+    }
+};
+
+static uint64_t compute_task_hash(const TaskProxy &task_proxy) {
+    KeyHasher hasher;
+    VariablesProxy variables = task_proxy.get_variables();
+    hasher.feed(variables.size());
+    for (VariableProxy var : variables)
+        hasher.feed(var.get_domain_size());
+    OperatorsProxy operators = task_proxy.get_operators();
+    hasher.feed(operators.size());
+    for (OperatorProxy op : operators) {
+        PreconditionsProxy preconditions = op.get_preconditions();
+        hasher.feed(preconditions.size());
+        for (FactProxy pre : preconditions)
+            hasher.feed(pre);
+        EffectsProxy effects = op.get_effects();
+        hasher.feed(effects.size());
+        for (EffectProxy effect : effects) {
+            EffectConditionsProxy conditions = effect.get_conditions();
+            hasher.feed(conditions.size());
+            for (FactProxy condition : conditions)
+                hasher.feed(condition);
+            hasher.feed(effect.get_fact());
+        }
+    }
+    hasher.feed(task_proxy.get_axioms().size());
+    GoalsProxy goals = task_proxy.get_goals();
+    hasher.feed(goals.size());
+    for (FactProxy goal : goals)
+        hasher.feed(goal);
+    // Only forward pruning depends on the initial state, but hashing
+    // it is cheap.
+    State initial_state = task_proxy.get_initial_state();
+    for (VariableProxy var : variables)
+        hasher.feed(initial_state[var].get_value());
+    return hasher.get_hash();
+}
+
+PDBCache::PDBCache(const TaskProxy &task_proxy, const string &directory)
+    : directory(directory),
+      task_hash(compute_task_hash(task_proxy)),
+      num_hits(0),
+      num_misses(0) {
+}
+
+uint64_t PDBCache::compute_key(
+    const TaskProxy &task_proxy, const Pattern &pattern,
+    const vector<int> &operator_costs, int bound, bool pareto,
+    bool forward_pruning) const {
+    KeyHasher hasher;
+    hasher.feed(task_hash);
+    hasher.feed(pattern.size());
+    for (int var : pattern)
+        hasher.feed(var);
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        hasher.feed(operator_costs.empty() ?
+                    op.get_cost() : operator_costs[op.get_id()]);
+    }
+    hasher.feed(bound);
+    hasher.feed(pareto);
+    hasher.feed(forward_pruning);
+    return hasher.get_hash();
+}
+
+string PDBCache::get_path(uint64_t key) const {
+    ostringstream path;
+    path << directory << "/" << hex << setw(16) << setfill('0') << key
+         << ".pdb";
+    return path.str();
+}
+
+bool PDBCache::load(uint64_t key, ParetoFrontTable &fronts) const {
+    shared_ptr<utils::MemoryMappedFile> file =
+        make_shared<utils::MemoryMappedFile>(get_path(key));
+    FileHeader header;
+    bool valid = file->is_open() && file->get_size() >= sizeof(FileHeader);
+    if (valid) {
+        memcpy(&header, file->get_data(), sizeof(FileHeader));
+        valid = memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+            header.key == key && header.size_t_size == sizeof(size_t) &&
+            fronts.map(file->get_data() + sizeof(FileHeader),
+                       file->get_size() - sizeof(FileHeader), file);
+    }
+    if (valid)
+        ++num_hits;
+    else
+        ++num_misses;
+    return valid;
+}
+
+void PDBCache::store(uint64_t key, const ParetoFrontTable &fronts) const {
+    static atomic<int> num_temporary_files(0);
+    const string path = get_path(key);
+    const string temporary_path =
+        path + ".tmp." + to_string(utils::get_process_id()) + "." +
+        to_string(num_temporary_files++);
+
+    FileHeader header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.key = key;
+    header.size_t_size = sizeof(size_t);
+    bool written;
+    {
+        ofstream out(temporary_path, ios::binary);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        fronts.write(out);
+        out.close();
+        written = !out.fail();
+    }
+    if (!written || rename(temporary_path.c_str(), path.c_str()) != 0) {
+        cerr << "Warning: could not write PDB cache file " << path << endl;
+        remove(temporary_path.c_str());
+    }
+}
+
+void PDBCache::print_statistics() const {
+    cout << "PDB cache: " << num_hits << " hits, " << num_misses
+         << " misses" << endl;
+}
+}
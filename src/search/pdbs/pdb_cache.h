@@ -0,0 +1,65 @@
+#ifndef PDBS_PDB_CACHE_H
+#define PDBS_PDB_CACHE_H
+
+#include "types.h"
+
+#include "../task_proxy.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ParetoFrontTable;
+
+namespace pdbs {
+/*
+  A directory of PDBs written to disk by earlier runs, so that runs on
+  the same task skip constructing them again.
+
+  A PDB is stored in a file named after a hash of the task, its
+  pattern, its operator costs, its cost bound and the kind of sweep
+  that computed it. The file holds the table of the backward sweep,
+  i.e. the distances or the Pareto fronts. Loading maps the file into
+  memory and uses the table in place, so nothing is copied and
+  concurrent planner processes share the pages.
+
+  Files are written under a temporary name and then renamed, so
+  concurrent runs never read a partially written file. The files are
+  only valid on machines with the same byte order and type sizes.
+*/
+class PDBCache {
+    std::string directory;
+    // Hash of everything in the task a PDB depends on, except costs.
+    std::uint64_t task_hash;
+
+    mutable std::atomic<int> num_hits;
+    mutable std::atomic<int> num_misses;
+
+    std::string get_path(std::uint64_t key) const;
+
+public:
+    // The directory must exist.
+    PDBCache(const TaskProxy &task_proxy, const std::string &directory);
+
+    /*
+      Key of the PDB for pattern with the given operator costs (or
+      the costs of the task if empty) and cost bound. pareto and
+      forward_pruning are the arguments of the construction.
+    */
+    std::uint64_t compute_key(
+        const TaskProxy &task_proxy, const Pattern &pattern,
+        const std::vector<int> &operator_costs, int bound, bool pareto,
+        bool forward_pruning) const;
+
+    // Maps the table stored for key into fronts. Returns false if
+    // there is no valid file for key.
+    bool load(std::uint64_t key, ParetoFrontTable &fronts) const;
+    // Failing to write the file only prints a warning.
+    void store(std::uint64_t key, const ParetoFrontTable &fronts) const;
+
+    void print_statistics() const;
+};
+}
+
+#endif
@@ -1,29 +1,61 @@
 #include "pdb_heuristic.h"
 
 #include "pattern_generator.h"
+#include "pdb_cache.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
 #include "../task_proxy.h"
 
+#include "../utils/memory.h"
+
 #include <limits>
 #include <memory>
 
 using namespace std;
 
 namespace pdbs {
-PatternDatabase get_pdb_from_options(const shared_ptr<AbstractTask> &task,
-                                     const Options &opts) {
+shared_ptr<PatternDatabase> get_pdb_from_options(
+    const shared_ptr<AbstractTask> &task, const Options &opts) {
     shared_ptr<PatternGenerator> pattern_generator =
         opts.get<shared_ptr<PatternGenerator>>("pattern");
     Pattern pattern = pattern_generator->generate(task);
     TaskProxy task_proxy(*task);
-    return PatternDatabase(task_proxy, pattern, true);
+    string cache_dir = opts.get<string>("cache_dir");
+    unique_ptr<PDBCache> pdb_cache;
+    if (cache_dir != "none")
+        pdb_cache = utils::make_unique_ptr<PDBCache>(task_proxy, cache_dir);
+    shared_ptr<PatternDatabase> pdb = make_shared<PatternDatabase>(
+        task_proxy, pattern, true, vector<int>(), opts.get<int>("bound"),
+        opts.get<bool>("pareto"), opts.get<bool>("forward_pruning"),
+        pdb_cache.get());
+    if (pdb_cache)
+        pdb_cache->print_statistics();
+    return pdb;
+}
+
+/*
+  In pareto mode, bounded queries go through a canonical heuristic over
+  the single PDB, so that the objectives behave exactly as for cpdbs.
+  The PDB already computed its pareto fronts during construction.
+*/
+static unique_ptr<CanonicalPDBs> get_pareto_pdbs_from_options(
+    const shared_ptr<PatternDatabase> &pdb, const Options &opts) {
+    if (!opts.get<bool>("pareto"))
+        return nullptr;
+    shared_ptr<PDBCollection> pdbs = make_shared<PDBCollection>(1, pdb);
+    shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets =
+        make_shared<MaxAdditivePDBSubsets>(1, *pdbs);
+    return unique_ptr<CanonicalPDBs>(new CanonicalPDBs(
+        pdbs, max_additive_subsets, false, true,
+        opts.get<string>("objective"), "max",
+        opts.get<bool>("objective_lookup")));
 }
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
     : Heuristic(opts),
-      pdb(get_pdb_from_options(task, opts)) {
+      pdb(get_pdb_from_options(task, opts)),
+      pareto_pdbs(get_pareto_pdbs_from_options(pdb, opts)) {
 }
 
 int PDBHeuristic::compute_heuristic(const GlobalState &global_state) {
@@ -32,7 +64,19 @@ int PDBHeuristic::compute_heuristic(const GlobalState &global_state) {
 }
 
 int PDBHeuristic::compute_heuristic(const State &state) const {
-    int h = pdb.get_value(state);
+    int h = pdb->get_value(state);
+    if (h == numeric_limits<int>::max())
+        return DEAD_END;
+    return h;
+}
+
+int PDBHeuristic::compute_heuristic(const GlobalState &global_state,
+                                    const int g, const int bound, const int u,
+                                    DepthHistogram *depth_histogram) {
+    State state = convert_global_state(global_state);
+    if (!pareto_pdbs)
+        return compute_heuristic(state);
+    int h = pareto_pdbs->get_value(state, g, bound, u, depth_histogram);
     if (h == numeric_limits<int>::max())
         return DEAD_END;
     return h;
@@ -52,6 +96,40 @@ static Heuristic *_parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy()");
+    parser.add_option<int>(
+        "bound",
+        "Cost bound for the pareto front computation. The fronts are "
+        "truncated at it, so the PDB is only valid for search bounds up to "
+        "it. With infinity, one PDB serves every bound.",
+        "infinity",
+        Bounds("-1", "infinity"));
+    parser.add_option<bool>(
+        "pareto",
+        "Use pareto front PDB",
+        "false");
+    parser.add_option<string>(
+        "objective",
+        "Objective function for pareto front iteration",
+        "h");
+    parser.add_option<bool>(
+        "objective_lookup",
+        "For the d, h and pts objectives, look up the best pair within the "
+        "remaining budget by binary search instead of scanning the pareto "
+        "front with the objective function.",
+        "true");
+    parser.add_option<bool>(
+        "forward_pruning",
+        "Before computing the pareto fronts, compute the abstract distances "
+        "from the initial state and drop all pairs whose abstract plan cost "
+        "exceeds the bound.",
+        "false");
+    parser.add_option<string>(
+        "cache_dir",
+        "Existing directory in which the PDB and its pareto fronts are "
+        "stored on disk, keyed by the task, pattern, operator costs and "
+        "cost bound. Later runs map them into memory instead of building "
+        "them again. none disables the cache.",
+        "none");
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
@@ -1,6 +1,7 @@
 #ifndef PDBS_PDB_HEURISTIC_H
 #define PDBS_PDB_HEURISTIC_H
 
+#include "canonical_pdbs.h"
 #include "pattern_database.h"
 
 #include "../heuristic.h"
@@ -15,7 +16,9 @@ class Options;
 namespace pdbs {
 // Implements a heuristic for a single PDB.
 class PDBHeuristic : public Heuristic {
-    PatternDatabase pdb;
+    std::shared_ptr<PatternDatabase> pdb;
+    // Only set in pareto mode.
+    std::unique_ptr<CanonicalPDBs> pareto_pdbs;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
     /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
@@ -23,6 +26,11 @@ protected:
        this, the following method already allows to get the heuristic value
        for a State object. */
     int compute_heuristic(const State &state) const;
+
+    virtual int compute_heuristic(const GlobalState &global_state,
+                                  const int g, const int bound,
+                                  const int u,
+                                  DepthHistogram *depth_histogram) override;
 public:
     /*
       Important: It is assumed that the pattern (passed via Options) is
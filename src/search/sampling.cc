@@ -8,6 +8,8 @@
 #include "utils/countdown_timer.h"
 #include "utils/rng.h"
 
+#include <utility>
+
 using namespace std;
 
 
@@ -18,7 +20,9 @@ vector<State> sample_states_with_random_walks(
     int init_h,
     double average_operator_cost,
     function<bool (State)> is_dead_end,
-    const utils::CountdownTimer *timer) {
+    const utils::CountdownTimer *timer,
+    vector<int> *sample_costs,
+    function<bool(const State &, int)> is_out_of_bound) {
     vector<State> samples;
 
     const State initial_state = task_proxy.get_initial_state();
@@ -42,6 +46,10 @@ vector<State> sample_states_with_random_walks(
        (We multiply by 2 because the heuristic is underestimating.) */
 
     samples.reserve(num_samples);
+    if (sample_costs) {
+        sample_costs->clear();
+        sample_costs->reserve(num_samples);
+    }
     for (int i = 0; i < num_samples; ++i) {
         if (timer && timer->is_expired())
             throw SamplingTimeout();
@@ -56,6 +64,7 @@ vector<State> sample_states_with_random_walks(
 
         // Sample one state with a random walk of length length.
         State current_state(initial_state);
+        int cost = 0;
         vector<OperatorProxy> applicable_ops;
         for (int j = 0; j < length; ++j) {
             applicable_ops.clear();
@@ -67,15 +76,26 @@ vector<State> sample_states_with_random_walks(
             } else {
                 const OperatorProxy &random_op = *g_rng()->choose(applicable_ops);
                 assert(is_applicable(random_op, current_state));
-                current_state = current_state.get_successor(random_op);
-                /* If current state is a dead end, then restart the random walk
+                State successor = current_state.get_successor(random_op);
+                int successor_cost = cost + random_op.get_cost();
+                /* If the successor is a dead end, then restart the random walk
                    with the initial state. */
-                if (is_dead_end(current_state))
+                if (is_dead_end(successor)) {
                     current_state = State(initial_state);
+                    cost = 0;
+                } else if (is_out_of_bound &&
+                           is_out_of_bound(successor, successor_cost)) {
+                    break;
+                } else {
+                    current_state = move(successor);
+                    cost = successor_cost;
+                }
             }
         }
         // The last state of the random walk is used as a sample.
         samples.push_back(current_state);
+        if (sample_costs)
+            sample_costs->push_back(cost);
     }
     return samples;
 }
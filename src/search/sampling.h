@@ -23,7 +23,11 @@ struct SamplingTimeout : public std::exception {};
   'is_dead_end' should return whether a given state is a dead end. If
   omitted, no dead end detection is performed. If 'timer' is given the
   sampling procedure will run for at most the specified time limit and
-  possibly return less than 'num_samples' states.
+  possibly return less than 'num_samples' states. If 'sample_costs'
+  is given, it receives the cost of the walk that led to each sample
+  (counted from the last restart). If 'is_out_of_bound' is given, a
+  walk ends early before the first state for which it returns true,
+  given the state and the cost of the walk to it.
 */
 std::vector<State> sample_states_with_random_walks(
     TaskProxy task_proxy,
@@ -34,6 +38,8 @@ std::vector<State> sample_states_with_random_walks(
     std::function<bool(State)> is_dead_end = [] (const State &) {
                                                  return false;
                                              },
-    const utils::CountdownTimer *timer = nullptr);
+    const utils::CountdownTimer *timer = nullptr,
+    std::vector<int> *sample_costs = nullptr,
+    std::function<bool(const State &, int)> is_out_of_bound = nullptr);
 
 #endif
@@ -14,10 +14,14 @@
 
 #include "../open_lists/open_list_factory.h"
 
+#include "../utils/memory.h"
+#include "../utils/thread_pool.h"
+
 #include <cassert>
 #include <cstdlib>
 #include <memory>
 #include <set>
+#include <unordered_set>
 
 using namespace std;
 
@@ -31,7 +35,11 @@ EagerSearch::EagerSearch(const Options &opts)
       f_evaluator(opts.get<ScalarEvaluator *>("f_eval", nullptr)),
       print_evaluator(opts.get<ScalarEvaluator *>("print_eval", nullptr)),
       preferred_operator_heuristics(opts.get_list<Heuristic *>("preferred")),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      num_threads(opts.get<int>("threads")) {
+}
+
+EagerSearch::~EagerSearch() {
 }
 
 void EagerSearch::initialize() {
@@ -65,6 +73,22 @@ void EagerSearch::initialize() {
     heuristics.assign(hset.begin(), hset.end());
     assert(!heuristics.empty());
 
+    if (num_threads > 1) {
+        for (Heuristic *heuristic : heuristics) {
+            if (heuristic->supports_concurrent_evaluation())
+                concurrent_heuristics.push_back(heuristic);
+        }
+        if (concurrent_heuristics.empty()) {
+            cout << "No heuristic supports concurrent evaluation, "
+                 << "evaluating successors sequentially" << endl;
+        } else {
+            cout << "Evaluating " << concurrent_heuristics.size()
+                 << " heuristic(s) of new successors with " << num_threads
+                 << " threads" << endl;
+            thread_pool = utils::make_unique_ptr<utils::ThreadPool>(num_threads);
+        }
+    }
+
     const GlobalState &initial_state = state_registry.get_initial_state();
     for (Heuristic *heuristic : heuristics) {
         heuristic->notify_initial_state(initial_state);
@@ -72,7 +96,7 @@ void EagerSearch::initialize() {
 
     // Note: we consider the initial state as reached by a preferred
     // operator.
-    EvaluationContext eval_context(initial_state, 0, true, &statistics, false, bound, 0);
+    EvaluationContext eval_context(initial_state, 0, true, &statistics, false, bound, 0, &depth_histogram);
 
     statistics.inc_evaluated_states();
 
@@ -124,10 +148,37 @@ SearchStatus EagerSearch::step() {
     pruning_method->prune_operators(s, applicable_ops);
 
     // This evaluates the expanded state (again) to get preferred ops
-    EvaluationContext eval_context(s, node.get_g(), false, &statistics, true, bound, node.get_u());
+    EvaluationContext eval_context(s, node.get_g(), false, &statistics, true, bound, node.get_u(), &depth_histogram);
     algorithms::OrderedSet<const GlobalOperator *> preferred_operators =
         collect_preferred_operators(eval_context, preferred_operator_heuristics);
 
+    if (thread_pool) {
+        // Generate all successors first, so the new ones can be evaluated
+        // in parallel before they are processed in operator order.
+        vector<Successor> successors;
+        for (const GlobalOperator *op : applicable_ops) {
+            if (node.get_g() + op->get_cost() > bound)
+                continue;
+
+            GlobalState succ_state = state_registry.get_successor_state(s, *op);
+            statistics.inc_generated();
+            successors.emplace_back(succ_state, op,
+                                    preferred_operators.contains(op));
+        }
+
+        evaluate_concurrently(node, successors);
+
+        for (const Successor &successor : successors) {
+            if (print_evaluator) {
+                eval_context.get_heuristic_value(print_evaluator);
+            }
+            process_successor(node, s, successor.op, successor.state,
+                              successor.is_preferred,
+                              successor.precomputed.get());
+        }
+        return IN_PROGRESS;
+    }
+
     for (const GlobalOperator *op : applicable_ops) {
       // Simple g-value out of bounds test
       // A bounded-cost heuristic should return dead end if it finds that
@@ -143,106 +194,155 @@ SearchStatus EagerSearch::step() {
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op);
 
-        SearchNode succ_node = search_space.get_node(succ_state);
+        process_successor(node, s, op, succ_state, is_preferred, nullptr);
+    }
+
+    return IN_PROGRESS;
+}
+
+void EagerSearch::process_successor(
+    const SearchNode &node, const GlobalState &s, const GlobalOperator *op,
+    const GlobalState &succ_state, bool is_preferred,
+    const HeuristicCache *precomputed) {
+    SearchNode succ_node = search_space.get_node(succ_state);
 
-	// Can safely prune here, even with bounded search,
-	// but only because we don't cache dead ends when bound < INF 
-	if(succ_node.is_dead_end())
-	  continue;
+    // Can safely prune here, even with bounded search,
+    // because out-of-bound states are not marked as dead ends.
+    if(succ_node.is_dead_end())
+      return;
 	
-        // update new path
-        if (use_multi_path_dependence || succ_node.is_new()) {
-            /*
-              Note: we must call notify_state_transition for each heuristic, so
-              don't break out of the for loop early.
-            */
-            for (Heuristic *heuristic : heuristics) {
-                heuristic->notify_state_transition(s, *op, succ_state);
-            }
+    // update new path
+    if (use_multi_path_dependence || succ_node.is_new()) {
+        /*
+          Note: we must call notify_state_transition for each heuristic, so
+          don't break out of the for loop early.
+        */
+        for (Heuristic *heuristic : heuristics) {
+            heuristic->notify_state_transition(s, *op, succ_state);
         }
+    }
 
-        if (succ_node.is_new()) {
-            // We have not seen this state before.
-            // Evaluate and create a new node.
-
-            // Careful: succ_node.get_g() is not available here yet,
-            // hence the stupid computation of succ_g.
-            // TODO: Make this less fragile.
-            int succ_g = node.get_g() + get_adjusted_cost(*op);
-	    int succ_u = node.get_u() + 1;
+    if (succ_node.is_new()) {
+        // We have not seen this state before.
+        // Evaluate and create a new node.
+
+        // Careful: succ_node.get_g() is not available here yet,
+        // hence the stupid computation of succ_g.
+        // TODO: Make this less fragile.
+        int succ_g = node.get_g() + get_adjusted_cost(*op);
+	int succ_u = node.get_u() + 1;
+
+	// It was out of bound with this g or less before, so it
+	// still is: no need to evaluate it again.
+	if (succ_node.is_out_of_bound(succ_g))
+	  return;
+
+        EvaluationContext eval_context(
+				       precomputed ? *precomputed : HeuristicCache(succ_state),
+				       succ_g, is_preferred, &statistics, false, bound, succ_u, &depth_histogram);
+        statistics.inc_evaluated_states();
+        if (precomputed) {
+            precomputed->for_each_heuristic_value(
+                [this](const Heuristic *, const EvaluationResult &result) {
+                    if (result.get_count_evaluation())
+                        statistics.inc_evaluations();
+                });
+        }
 
-            EvaluationContext eval_context(
-					   succ_state, succ_g, is_preferred, &statistics, false, bound, succ_u);
-            statistics.inc_evaluated_states();
-
-            if (open_list->is_dead_end(eval_context) ||
-		(f_evaluator &&
-		 eval_context.get_heuristic_value(f_evaluator) > bound)) {
-	      if(bound == EvaluationResult::INFTY) {
-		// Bounded search dead ends may just be out of bounds
-		// in which case, they should be re-evaluated.
-		// TODO: This should be changed so that true dead ends can be marked (cached),
-		//       but out-of-bounds nodes are not marked.
-		//       We need a way to distinguish out-of-bounds and dead end.
-		succ_node.mark_as_dead_end();
-	      }
-	      statistics.inc_dead_ends();
-	      continue;
-            }
-            succ_node.open(node, op);
+        if (open_list->is_dead_end(eval_context) ||
+	    (f_evaluator &&
+	     eval_context.get_heuristic_value(f_evaluator) > bound)) {
+	  if(bound == EvaluationResult::INFTY) {
+	    succ_node.mark_as_dead_end();
+	  } else {
+	    // Bounded search dead ends may just be out of bounds,
+	    // so only reaching the state more cheaply evaluates it
+	    // again.
+	    succ_node.mark_as_out_of_bound(succ_g);
+	  }
+	  statistics.inc_dead_ends();
+	  return;
+        }
+        succ_node.open(node, op);
 
-            open_list->insert(eval_context, succ_state.get_id());
-            if (search_progress.check_progress(eval_context)) {
-                print_checkpoint_line(succ_node.get_g());
-                reward_progress();
-            }
-        } else if (succ_node.get_g() > node.get_g() + get_adjusted_cost(*op)) {
-            // We found a new cheapest path to an open or closed state.
+        open_list->insert(eval_context, succ_state.get_id());
+        if (search_progress.check_progress(eval_context)) {
+            print_checkpoint_line(succ_node.get_g());
+            reward_progress();
+        }
+    } else if (succ_node.get_g() > node.get_g() + get_adjusted_cost(*op)) {
+        // We found a new cheapest path to an open or closed state.
 	  
-            if (reopen_closed_nodes) {
-                if (succ_node.is_closed()) {
-                    /*
-                      TODO: It would be nice if we had a way to test
-                      that reopening is expected behaviour, i.e., exit
-                      with an error when this is something where
-                      reopening should not occur (e.g. A* with a
-                      consistent heuristic).
-                    */
-                    statistics.inc_reopened();
-                }
-                succ_node.reopen(node, op);
-
-                EvaluationContext eval_context(
-					       succ_state, succ_node.get_g(), is_preferred, &statistics, false, bound, succ_node.get_u());
-
+        if (reopen_closed_nodes) {
+            if (succ_node.is_closed()) {
                 /*
-                  Note: our old code used to retrieve the h value from
-                  the search node here. Our new code recomputes it as
-                  necessary, thus avoiding the incredible ugliness of
-                  the old "set_evaluator_value" approach, which also
-                  did not generalize properly to settings with more
-                  than one heuristic.
-
-                  Reopening should not happen all that frequently, so
-                  the performance impact of this is hopefully not that
-                  large. In the medium term, we want the heuristics to
-                  remember heuristic values for states themselves if
-                  desired by the user, so that such recomputations
-                  will just involve a look-up by the Heuristic object
-                  rather than a recomputation of the heuristic value
-                  from scratch.
+                  TODO: It would be nice if we had a way to test
+                  that reopening is expected behaviour, i.e., exit
+                  with an error when this is something where
+                  reopening should not occur (e.g. A* with a
+                  consistent heuristic).
                 */
-                open_list->insert(eval_context, succ_state.get_id());
-            } else {
-                // If we do not reopen closed nodes, we just update the parent pointers.
-                // Note that this could cause an incompatibility between
-                // the g-value and the actual path that is traced back.
-                succ_node.update_parent(node, op);
+                statistics.inc_reopened();
             }
+            succ_node.reopen(node, op);
+
+            EvaluationContext eval_context(
+					   succ_state, succ_node.get_g(), is_preferred, &statistics, false, bound, succ_node.get_u(), &depth_histogram);
+
+            /*
+              Note: our old code used to retrieve the h value from
+              the search node here. Our new code recomputes it as
+              necessary, thus avoiding the incredible ugliness of
+              the old "set_evaluator_value" approach, which also
+              did not generalize properly to settings with more
+              than one heuristic.
+
+              Reopening should not happen all that frequently, so
+              the performance impact of this is hopefully not that
+              large. In the medium term, we want the heuristics to
+              remember heuristic values for states themselves if
+              desired by the user, so that such recomputations
+              will just involve a look-up by the Heuristic object
+              rather than a recomputation of the heuristic value
+              from scratch.
+            */
+            open_list->insert(eval_context, succ_state.get_id());
+        } else {
+            // If we do not reopen closed nodes, we just update the parent pointers.
+            // Note that this could cause an incompatibility between
+            // the g-value and the actual path that is traced back.
+            succ_node.update_parent(node, op);
         }
     }
+}
 
-    return IN_PROGRESS;
+void EagerSearch::evaluate_concurrently(
+    const SearchNode &node, vector<Successor> &successors) {
+    unordered_set<StateID> new_states;
+    for (Successor &successor : successors) {
+        SearchNode succ_node = search_space.get_node(successor.state);
+        if (!succ_node.is_new())
+            continue;
+        int succ_g = node.get_g() + get_adjusted_cost(*successor.op);
+        int succ_u = node.get_u() + 1;
+        if (succ_node.is_out_of_bound(succ_g) ||
+            !new_states.insert(successor.state.get_id()).second)
+            continue;
+
+        successor.precomputed =
+            utils::make_unique_ptr<HeuristicCache>(successor.state);
+        thread_pool->submit(
+            [this, &successor, succ_g, succ_u]() {
+                EvaluationContext eval_context(
+                    successor.state, succ_g, successor.is_preferred, nullptr,
+                    false, bound, succ_u, &depth_histogram);
+                for (Heuristic *heuristic : concurrent_heuristics) {
+                    (*successor.precomputed)[heuristic] =
+                        heuristic->compute_result_concurrently(eval_context);
+                }
+            });
+    }
+    thread_pool->wait();
 }
 
 pair<SearchNode, bool> EagerSearch::fetch_next_node() {
@@ -283,7 +383,7 @@ pair<SearchNode, bool> EagerSearch::fetch_next_node() {
 
             if (!node.is_closed()) {
                 EvaluationContext eval_context(
-					       node.get_state(), node.get_g(), false, &statistics, false, bound, node.get_u());
+					       node.get_state(), node.get_g(), false, &statistics, false, bound, node.get_u(), &depth_histogram);
 
                 if (open_list->is_dead_end(eval_context)) {
                     node.mark_as_dead_end();
@@ -331,12 +431,27 @@ void EagerSearch::update_f_value_statistics(const SearchNode &node) {
           TODO: This code doesn't fit the idea of supporting
           an arbitrary f evaluator.
         */
-      EvaluationContext eval_context(node.get_state(), node.get_g(), false, &statistics, false, bound, node.get_u());
+      EvaluationContext eval_context(node.get_state(), node.get_g(), false, &statistics, false, bound, node.get_u(), &depth_histogram);
         int f_value = eval_context.get_heuristic_value(f_evaluator);
         statistics.report_f_value_progress(f_value);
     }
 }
 
+static void add_threads_option(OptionParser &parser) {
+    parser.add_option<int>(
+        "threads",
+        "Number of threads for evaluating the new successors of an "
+        "expansion. Only heuristics that support concurrent evaluation "
+        "are evaluated in parallel, currently cpdbs without the ework "
+        "objective and merge_and_shrink, and only if they are created "
+        "with cache_estimates=false (the default is true). The search "
+        "itself does not change. The thread pool adds overhead to every "
+        "expansion, so more threads only pay off for expensive "
+        "heuristics on machines with spare cores.",
+        "1",
+        Bounds("1", "infinity"));
+}
+
 /* TODO: merge this into SearchEngine::add_options_to_parser when all search
          engines support pruning. */
 void add_pruning_option(OptionParser &parser) {
@@ -369,6 +484,7 @@ static SearchEngine *_parse(OptionParser &parser) {
         "use preferred operators of these heuristics", "[]");
 
     add_pruning_option(parser);
+    add_threads_option(parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
@@ -406,6 +522,7 @@ static SearchEngine *_parse_astar(OptionParser &parser) {
                             "use multi-path dependence (LM-A*)", "false");
 
     add_pruning_option(parser);
+    add_threads_option(parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
@@ -472,6 +589,7 @@ static SearchEngine *_parse_greedy(OptionParser &parser) {
         "boost value for preferred operator open lists", "0");
 
     add_pruning_option(parser);
+    add_threads_option(parser);
     SearchEngine::add_options_to_parser(parser);
 
     Options opts = parser.parse();
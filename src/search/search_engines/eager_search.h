@@ -1,6 +1,8 @@
 #ifndef SEARCH_ENGINES_EAGER_SEARCH_H
 #define SEARCH_ENGINES_EAGER_SEARCH_H
 
+#include "../depth_histogram.h"
+#include "../heuristic_cache.h"
 #include "../search_engine.h"
 
 #include "../open_lists/open_list.h"
@@ -17,6 +19,10 @@ namespace options {
 class Options;
 }
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace eager_search {
 class EagerSearch : public SearchEngine {
     const bool reopen_closed_nodes;
@@ -31,6 +37,54 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    // Evaluations per depth, for heuristics that estimate b.
+    DepthHistogram depth_histogram;
+
+    /*
+      With more than one thread, all successors of an expansion are
+      generated first and the heuristics that support concurrent
+      evaluation are evaluated for the new ones in parallel. Then the
+      successors are processed in order as usual, so the search behaves
+      as with one thread, where each successor is processed right after
+      it is generated.
+    */
+    const int num_threads;
+    std::vector<Heuristic *> concurrent_heuristics;
+    // nullptr if the successors are evaluated sequentially.
+    std::unique_ptr<utils::ThreadPool> thread_pool;
+
+    struct Successor {
+        GlobalState state;
+        const GlobalOperator *op;
+        bool is_preferred;
+        // Results of concurrent_heuristics, or nullptr if not evaluated.
+        std::unique_ptr<HeuristicCache> precomputed;
+
+        Successor(const GlobalState &state, const GlobalOperator *op,
+                  bool is_preferred)
+            : state(state), op(op), is_preferred(is_preferred) {
+        }
+    };
+
+    /*
+      Handles a generated successor of node: notifies the heuristics,
+      then evaluates and opens a new state or updates the path to a
+      known one. precomputed holds results of evaluate_concurrently,
+      or is nullptr.
+    */
+    void process_successor(
+        const SearchNode &node, const GlobalState &s, const GlobalOperator *op,
+        const GlobalState &succ_state, bool is_preferred,
+        const HeuristicCache *precomputed);
+
+    /*
+      Computes the precomputed results of the successors that are new,
+      not known to be out of the bound and not duplicates of earlier
+      successors in the list, on the thread pool.
+    */
+    void evaluate_concurrently(
+        const SearchNode &node, std::vector<Successor> &successors);
+
     std::pair<SearchNode, bool> fetch_next_node();
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(const SearchNode &node);
@@ -43,7 +97,7 @@ protected:
 
 public:
     explicit EagerSearch(const options::Options &opts);
-    virtual ~EagerSearch() = default;
+    virtual ~EagerSearch() override;
 
     virtual void print_statistics() const override;
 
@@ -106,6 +106,12 @@ void LazySearch::generate_successors() {
         int new_g = current_g + get_adjusted_cost(*op);
         int new_real_g = current_real_g + op->get_cost();
         bool is_preferred = preferred_operators.contains(op);
+        /*
+          Without reopen_closed, a state is only expanded with the
+          first path that reaches it. If that path is too expensive
+          for the bound, cheaper paths to the state are not tried, so
+          bounded lazy search is incomplete then.
+        */
         if (new_real_g < bound) {
             EvaluationContext new_eval_context(
                 current_eval_context.get_cache(), new_g, is_preferred, nullptr);
@@ -3,24 +3,39 @@
 
 #include "state_id.h"
 
+#include <limits>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
-class GlobalOperator;
-
+/*
+  Kept small because one is stored for every registered state. The
+  creating operator is stored as an index into g_operators, and the
+  real g-value of searches with adjusted operator costs lives in a
+  separate table of the SearchSpace, so that searches with normal costs
+  do not pay for it.
+*/
 struct SearchNodeInfo {
   enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
 
     unsigned int status : 2;
     int g : 30;
     StateID parent_state_id;
-    const GlobalOperator *creating_operator;
-    int real_g;
+    // Index into g_operators, or -1 for the initial state.
+    int creating_operator;
     int u;
+    /*
+      Smallest g with which the state was generated and found to be
+      out of the cost bound, so reaching it again with a g that is not
+      smaller need not evaluate it again. Dead ends in unbounded search
+      have status DEAD_END instead.
+    */
+    int out_of_bound_g;
 
     SearchNodeInfo()
         : status(NEW), g(-1), parent_state_id(StateID::no_state),
-      creating_operator(nullptr), real_g(-1), u(-1) {
+      creating_operator(-1), u(-1),
+      out_of_bound_g(std::numeric_limits<int>::max()) {
     }
 };
 
@@ -4,20 +4,36 @@
 #include "global_state.h"
 #include "globals.h"
 
+#include <algorithm>
 #include <cassert>
 #include "search_node_info.h"
 
 using namespace std;
 
+static int get_op_index(const GlobalOperator *op) {
+    int op_index = op - &*g_operators.begin();
+    assert(op_index >= 0 && op_index < static_cast<int>(g_operators.size()));
+    return op_index;
+}
+
+static const GlobalOperator *get_creating_operator(const SearchNodeInfo &info) {
+    if (info.creating_operator == -1)
+        return nullptr;
+    return &g_operators[info.creating_operator];
+}
+
 SearchNode::SearchNode(const StateRegistry &state_registry,
                        StateID state_id,
                        SearchNodeInfo &info,
+                       int *real_g,
                        OperatorCost cost_type)
     : state_registry(state_registry),
       state_id(state_id),
       info(info),
+      real_g(real_g),
       cost_type(cost_type) {
     assert(state_id != StateID::no_state);
+    assert((real_g == nullptr) == (cost_type == NORMAL));
 }
 
 GlobalState SearchNode::get_state() const {
@@ -36,6 +52,10 @@ bool SearchNode::is_dead_end() const {
     return info.status == SearchNodeInfo::DEAD_END;
 }
 
+bool SearchNode::is_out_of_bound(int g) const {
+    return g >= info.out_of_bound_g;
+}
+
 bool SearchNode::is_new() const {
     return info.status == SearchNodeInfo::NEW;
 }
@@ -46,7 +66,7 @@ int SearchNode::get_g() const {
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    return real_g ? *real_g : info.g;
 }
 
 int SearchNode::get_u() const {
@@ -57,10 +77,11 @@ void SearchNode::open_initial() {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = 0;
-    info.real_g = 0;
+    if (real_g)
+        *real_g = 0;
     info.u = 0;
     info.parent_state_id = StateID::no_state;
-    info.creating_operator = 0;
+    info.creating_operator = -1;
 }
 
 void SearchNode::open(const SearchNode &parent_node,
@@ -68,10 +89,11 @@ void SearchNode::open(const SearchNode &parent_node,
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = parent_node.info.g + get_adjusted_action_cost(*parent_op, cost_type);
-    info.real_g = parent_node.info.real_g + 1;
+    if (real_g)
+        *real_g = parent_node.get_real_g() + parent_op->get_cost();
     info.u = parent_node.info.u + 1;
     info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = parent_op;
+    info.creating_operator = get_op_index(parent_op);
 }
 
 void SearchNode::reopen(const SearchNode &parent_node,
@@ -83,10 +105,11 @@ void SearchNode::reopen(const SearchNode &parent_node,
     // may require reopening closed nodes.
     info.status = SearchNodeInfo::OPEN;
     info.g = parent_node.info.g + get_adjusted_action_cost(*parent_op, cost_type);
-    info.real_g = parent_node.info.real_g + parent_op->get_cost();
+    if (real_g)
+        *real_g = parent_node.get_real_g() + parent_op->get_cost();
     info.u = parent_node.info.u + 1;
     info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = parent_op;
+    info.creating_operator = get_op_index(parent_op);
 }
 
 // like reopen, except doesn't change status
@@ -97,9 +120,10 @@ void SearchNode::update_parent(const SearchNode &parent_node,
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
     info.g = parent_node.info.g + get_adjusted_action_cost(*parent_op, cost_type);
-    info.real_g = parent_node.info.real_g + parent_op->get_cost();
+    if (real_g)
+        *real_g = parent_node.get_real_g() + parent_op->get_cost();
     info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = parent_op;
+    info.creating_operator = get_op_index(parent_op);
 }
 
 void SearchNode::close() {
@@ -111,11 +135,16 @@ void SearchNode::mark_as_dead_end() {
     info.status = SearchNodeInfo::DEAD_END;
 }
 
+void SearchNode::mark_as_out_of_bound(int g) {
+    assert(info.status == SearchNodeInfo::NEW);
+    info.out_of_bound_g = min(info.out_of_bound_g, g);
+}
+
 void SearchNode::dump() const {
     cout << state_id << ": ";
     get_state().dump_fdr();
-    if (info.creating_operator) {
-        cout << " created by " << info.creating_operator->get_name()
+    if (const GlobalOperator *op = get_creating_operator(info)) {
+        cout << " created by " << op->get_name()
              << " from " << info.parent_state_id << endl;
     } else {
         cout << " no parent" << endl;
@@ -123,13 +152,16 @@ void SearchNode::dump() const {
 }
 
 SearchSpace::SearchSpace(StateRegistry &state_registry, OperatorCost cost_type)
-    : state_registry(state_registry),
+    : real_g_values(-1),
+      state_registry(state_registry),
       cost_type(cost_type) {
 }
 
 SearchNode SearchSpace::get_node(const GlobalState &state) {
+    int *real_g = (cost_type == NORMAL) ? nullptr : &real_g_values[state];
     return SearchNode(
-        state_registry, state.get_id(), search_node_infos[state], cost_type);
+        state_registry, state.get_id(), search_node_infos[state], real_g,
+        cost_type);
 }
 
 void SearchSpace::trace_path(const GlobalState &goal_state,
@@ -138,7 +170,7 @@ void SearchSpace::trace_path(const GlobalState &goal_state,
     assert(path.empty());
     for (;;) {
         const SearchNodeInfo &info = search_node_infos[current_state];
-        const GlobalOperator *op = info.creating_operator;
+        const GlobalOperator *op = get_creating_operator(info);
         if (op == 0) {
             assert(info.parent_state_id == StateID::no_state);
             break;
@@ -158,8 +190,9 @@ void SearchSpace::dump() const {
         const SearchNodeInfo &node_info = search_node_infos[s];
         cout << id << ": ";
         s.dump_fdr();
-        if (node_info.creating_operator && node_info.parent_state_id != StateID::no_state) {
-            cout << " created by " << node_info.creating_operator->get_name()
+        const GlobalOperator *op = get_creating_operator(node_info);
+        if (op && node_info.parent_state_id != StateID::no_state) {
+            cout << " created by " << op->get_name()
                  << " from " << node_info.parent_state_id << endl;
         } else {
             cout << "has no parent" << endl;
@@ -16,11 +16,14 @@ class SearchNode {
     const StateRegistry &state_registry;
     StateID state_id;
     SearchNodeInfo &info;
+    // nullptr if the operator costs are not adjusted (real g equals g).
+    int *real_g;
     OperatorCost cost_type;
 public:
     SearchNode(const StateRegistry &state_registry,
                StateID state_id,
                SearchNodeInfo &info,
+               int *real_g,
                OperatorCost cost_type);
 
     StateID get_state_id() const {
@@ -32,6 +35,8 @@ public:
     bool is_open() const;
     bool is_closed() const;
     bool is_dead_end() const;
+    // True iff the state was out of the bound when generated with g or less.
+    bool is_out_of_bound(int g) const;
 
     int get_g() const;
     int get_real_g() const;
@@ -46,6 +51,7 @@ public:
                        const GlobalOperator *parent_op);
     void close();
     void mark_as_dead_end();
+    void mark_as_out_of_bound(int g);
 
     void dump() const;
 };
@@ -53,6 +59,8 @@ public:
 
 class SearchSpace {
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    // Only used if the operator costs are adjusted.
+    PerStateInformation<int> real_g_values;
 
     StateRegistry &state_registry;
     OperatorCost cost_type;
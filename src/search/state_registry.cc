@@ -15,7 +15,6 @@ StateRegistry::StateRegistry(
       num_variables(initial_state_data.size()),
       state_data_pool(get_bins_per_state()),
       registered_states(
-          0,
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())),
       cached_initial_state(0) {
@@ -37,14 +36,14 @@ StateID StateRegistry::insert_id_or_pop_state() {
       is present), we have to remove the duplicate entry from the
       state data pool.
     */
-    StateID id(state_data_pool.size() - 1);
-    pair<StateIDSet::iterator, bool> result = registered_states.insert(id);
+    int id = state_data_pool.size() - 1;
+    pair<int, bool> result = registered_states.insert(id);
     bool is_new_entry = result.second;
     if (!is_new_entry) {
         state_data_pool.pop_back();
     }
     assert(registered_states.size() == state_data_pool.size());
-    return *result.first;
+    return StateID(result.first);
 }
 
 GlobalState StateRegistry::lookup_state(StateID id) const {
@@ -0,0 +1,57 @@
+#include "memory_mapped_file.h"
+
+#include "system.h"
+
+#if OPERATING_SYSTEM == WINDOWS
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+#if OPERATING_SYSTEM == WINDOWS
+MemoryMappedFile::MemoryMappedFile(const string &path)
+    : data(nullptr),
+      size(0) {
+    ifstream file(path, ios::binary);
+    if (!file)
+        return;
+    buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    size = buffer.size();
+    data = buffer.data();
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+}
+#else
+MemoryMappedFile::MemoryMappedFile(const string &path)
+    : data(nullptr),
+      size(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+    struct stat file_status;
+    if (fstat(fd, &file_status) == 0 && file_status.st_size > 0) {
+        void *mapping = mmap(nullptr, file_status.st_size, PROT_READ,
+                             MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            data = static_cast<const char *>(mapping);
+            size = file_status.st_size;
+        }
+    }
+    // The mapping stays valid after the file is closed.
+    close(fd);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (data)
+        munmap(const_cast<char *>(data), size);
+}
+#endif
+}
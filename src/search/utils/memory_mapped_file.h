@@ -0,0 +1,43 @@
+#ifndef UTILS_MEMORY_MAPPED_FILE_H
+#define UTILS_MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  A file mapped read-only into memory. The mapping is shared, so
+  processes that map the same file share its pages.
+
+  On Windows, the file is read into memory instead.
+*/
+class MemoryMappedFile {
+    const char *data;
+    std::size_t size;
+    // Contents of the file if it could not be mapped.
+    std::vector<char> buffer;
+
+public:
+    // Check is_open() to see whether the file could be opened.
+    explicit MemoryMappedFile(const std::string &path);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    bool is_open() const {
+        return data != nullptr;
+    }
+
+    const char *get_data() const {
+        return data;
+    }
+
+    std::size_t get_size() const {
+        return size;
+    }
+};
+}
+
+#endif
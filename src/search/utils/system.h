@@ -45,6 +45,8 @@ enum class ExitCode {
 NO_RETURN extern void exit_with(ExitCode returncode);
 
 int get_peak_memory_in_kb();
+// Returns the limit on the address space of the process, or -1 if none.
+long long get_memory_limit_in_kb();
 const char *get_exit_code_message_reentrant(ExitCode exitcode);
 bool is_exit_code_error_reentrant(ExitCode exitcode);
 void register_event_handlers();
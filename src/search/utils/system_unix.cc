@@ -32,6 +32,7 @@
 #include <limits>
 #include <new>
 #include <stdlib.h>
+#include <sys/resource.h>
 #include <unistd.h>
 
 #if OPERATING_SYSTEM == OSX
@@ -215,6 +216,14 @@ int get_peak_memory_in_kb() {
     return memory_in_kb;
 }
 
+long long get_memory_limit_in_kb() {
+    // Memory limits are imposed on the address space, e.g. by ulimit -v.
+    rlimit limit;
+    if (getrlimit(RLIMIT_AS, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY)
+        return -1;
+    return static_cast<long long>(limit.rlim_cur / 1024);
+}
+
 void register_event_handlers() {
     // Terminate when running out of memory.
     set_new_handler(out_of_memory_handler);
@@ -71,6 +71,11 @@ void report_exit_code_reentrant(ExitCode exitcode) {
     }
 }
 
+long long get_memory_limit_in_kb() {
+    // Memory limits are not supported on Windows.
+    return -1;
+}
+
 int get_process_id() {
     return _getpid();
 }
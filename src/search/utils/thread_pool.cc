@@ -0,0 +1,75 @@
+#include "thread_pool.h"
+
+#include <cassert>
+#include <utility>
+
+using namespace std;
+
+namespace utils {
+ThreadPool::ThreadPool(int num_threads)
+    : num_unfinished(0),
+      stopping(false) {
+    assert(num_threads >= 1);
+    if (num_threads > 1) {
+        workers.reserve(num_threads);
+        for (int i = 0; i < num_threads; ++i)
+            workers.emplace_back(&ThreadPool::run_worker, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (thread &worker : workers)
+        worker.join();
+}
+
+int ThreadPool::get_num_threads() const {
+    return workers.empty() ? 1 : workers.size();
+}
+
+void ThreadPool::run_worker() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(queue_mutex);
+            task_available.wait(lock, [this]() {
+                                    return stopping || !tasks.empty();
+                                });
+            if (tasks.empty())
+                return;
+            task = move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            --num_unfinished;
+            if (num_unfinished == 0)
+                all_done.notify_all();
+        }
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    if (workers.empty()) {
+        task();
+        return;
+    }
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        tasks.push_back(move(task));
+        ++num_unfinished;
+    }
+    task_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> lock(queue_mutex);
+    all_done.wait(lock, [this]() {return num_unfinished == 0; });
+}
+}
@@ -0,0 +1,50 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  A fixed set of worker threads that run submitted tasks in FIFO order.
+
+  With a single thread, no worker is started and submit() runs the task
+  right away in the calling thread, so code using the pool behaves
+  exactly like a sequential loop by default.
+
+  Tasks must not throw. The destructor waits for all submitted tasks.
+*/
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex queue_mutex;
+    std::condition_variable task_available;
+    std::condition_variable all_done;
+    // Tasks that were submitted but have not finished yet.
+    std::size_t num_unfinished;
+    bool stopping;
+
+    void run_worker();
+
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int get_num_threads() const;
+
+    void submit(std::function<void()> task);
+
+    // Blocks until all submitted tasks have finished.
+    void wait();
+};
+}
+
+#endif